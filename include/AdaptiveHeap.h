@@ -0,0 +1,392 @@
+#ifndef ADAPTIVEHEAP_H
+#define ADAPTIVEHEAP_H
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "DaryHeap.h"
+#include "FibHeap.h"
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PairingHeap.h"
+#include "error_handler.h"
+
+/**
+ * @class AdaptiveHeap
+ * @brief Front-end that watches its operation mix and moves its nodes to the engine that suits it.
+ *
+ * Operations are counted over a window of at least max(minWindow, size) calls.
+ * At the end of each window the mix is classified:
+ *
+ * - almost no key changes and no melds: DaryHeap, whose flat array wins on insert/extract;
+ * - many key changes or any melds on a large heap: FibHeap, with O(1) amortized decrease-key;
+ * - anything else: PairingHeap.
+ *
+ * A new engine is adopted only if two windows in a row ask for it. The old
+ * engine then hands over its nodes by walking its own structure, and the new one
+ * loads them in a single linear bulk build. Nodes are never copied, so handles
+ * stay valid across moves. A move takes O(n), and because the window is at least
+ * as long as the heap, that is O(1) amortized per operation of the window.
+ *
+ * Every engine stores nodes through NodeNewDelete, so a node can be freed by
+ * whichever engine holds it.
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Compare Strict weak ordering on keys; the node that compares first is the minimum.
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key> >
+class AdaptiveHeap {
+public:
+    /**
+     * @brief The engines an adaptive heap can run on.
+     */
+    enum class EngineKind {
+        Dary, ///< DaryHeap with arity 4.
+        Pairing, ///< PairingHeap.
+        Fibonacci ///< FibHeap.
+    };
+
+private:
+    static constexpr int minWindow = 256; ///< Fewest operations sampled before the mix is classified.
+    static constexpr int largeHeap = 4096; ///< Size from which key-change heavy queues move to FibHeap.
+
+    DaryHeap<Key, Value, 4, Compare, NodeNewDelete> dary;
+    PairingHeap<Key, Value, Compare, NodeNewDelete> pairing;
+    FibHeap<Key, Value, Compare, NodeNewDelete> fib;
+    EngineKind engine; ///< The engine currently holding the nodes.
+    EngineKind proposed; ///< The engine asked for by the last window.
+    error_handler *handler;
+
+    int operations = 0; ///< Operations counted in the current window.
+    int keyChanges = 0; ///< Calls that changed a key in the current window; rejected and no-op calls do not count.
+    int melds = 0; ///< meld calls in the current window.
+
+    /**
+     * @brief Calls f with the engine currently holding the nodes.
+     */
+    template<typename Self, typename F>
+    static decltype(auto) visit(Self &self, F &&f);
+
+    /**
+     * @brief Counts one operation and, at the end of a window, classifies the mix and moves if asked twice.
+     */
+    void sample();
+
+    /**
+     * @brief Moves every node into another engine with one detachAll() and one insertNodes().
+     */
+    void migrate(EngineKind to);
+
+public:
+    /**
+     * @brief Stable reference to a node in the heap.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
+    /**
+     * @brief Constructs a new, empty adaptive heap running on the given engine.
+     */
+    AdaptiveHeap(error_handler *handler, EngineKind initial = EngineKind::Pairing);
+
+    AdaptiveHeap(const AdaptiveHeap &) = delete;
+    AdaptiveHeap &operator=(const AdaptiveHeap &) = delete;
+
+    /**
+     * @brief Gets the engine currently holding the nodes.
+     */
+    EngineKind currentEngine() const;
+
+    /**
+     * @brief Allocates a node without inserting it.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Frees a node that is no longer in the heap.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the heap.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the heap.
+     *
+     * @param x The node to be inserted.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the heap.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Lowers the key of a node.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the heap without searching for it.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another adaptive heap into this one, first moving it onto this heap's engine if needed.
+     *
+     * @param other The heap to meld into this one. It is left empty.
+     */
+    void meld(AdaptiveHeap &&other);
+
+    /**
+     * @brief Extracts the minimum node from the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the heap.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the minimum node in the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Modifies the key of a node.
+     */
+    void modifyKey(Key k, Key new_k);
+
+    /**
+     * @brief Deletes a node with a specific key from the heap and frees it.
+     */
+    void deleteNode(Key k);
+
+    /**
+     * @brief Displays the current engine and its structure.
+     */
+    void display();
+
+    /**
+     * @brief Finds a node with a specific key in the heap.
+     */
+    Node<Value, Key> *find(Key key) const;
+
+    /**
+     * @brief Checks if the heap is empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the heap.
+     */
+    int getSize();
+};
+
+// Implementation of the AdaptiveHeap template class
+
+template<typename Key, typename Value, typename Compare>
+AdaptiveHeap<Key, Value, Compare>::AdaptiveHeap(error_handler *handler, EngineKind initial)
+    : dary(handler), pairing(handler), fib(handler), engine(initial), proposed(initial), handler(handler) {}
+
+template<typename Key, typename Value, typename Compare>
+template<typename Self, typename F>
+decltype(auto) AdaptiveHeap<Key, Value, Compare>::visit(Self &self, F &&f) {
+    switch (self.engine) {
+        case EngineKind::Dary:
+            return f(self.dary);
+        case EngineKind::Fibonacci:
+            return f(self.fib);
+        default:
+            return f(self.pairing);
+    }
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::sample() {
+    int size = getSize();
+    if (++operations < std::max(minWindow, size)) return;
+
+    EngineKind wanted;
+    if (melds == 0 && keyChanges * 32 < operations)
+        wanted = EngineKind::Dary;
+    else if ((melds > 0 || keyChanges * 4 >= operations) && size >= largeHeap)
+        wanted = EngineKind::Fibonacci;
+    else
+        wanted = EngineKind::Pairing;
+
+    if (wanted != engine && wanted == proposed)
+        migrate(wanted);
+    proposed = wanted;
+    operations = keyChanges = melds = 0;
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::migrate(EngineKind to) {
+    std::vector<handle> nodes;
+    nodes.reserve(getSize());
+    visit(*this, [&](auto &from) { from.detachAll(nodes); });
+    engine = to;
+    visit(*this, [&](auto &into) { into.insertNodes(nodes.begin(), nodes.end()); });
+    handler->verbose_log(13, "Migrated to another engine.");
+}
+
+template<typename Key, typename Value, typename Compare>
+typename AdaptiveHeap<Key, Value, Compare>::EngineKind AdaptiveHeap<Key, Value, Compare>::currentEngine() const {
+    return engine;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename AdaptiveHeap<Key, Value, Compare>::handle
+AdaptiveHeap<Key, Value, Compare>::createNode(Value Name, Key key) {
+    return pairing.createNode(Name, key);
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::destroyNode(handle x) {
+    pairing.destroyNode(x);
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::clear() {
+    visit(*this, [](auto &e) { e.clear(); });
+    operations = keyChanges = melds = 0;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename AdaptiveHeap<Key, Value, Compare>::handle
+AdaptiveHeap<Key, Value, Compare>::insert(Node<Value, Key> *x) {
+    handle result = visit(*this, [&](auto &e) { return e.insert(x); });
+    sample();
+    return result;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename AdaptiveHeap<Key, Value, Compare>::handle
+AdaptiveHeap<Key, Value, Compare>::insert(Value Name, Key key) {
+    return insert(createNode(Name, key));
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::decreaseKey(handle x, Key k) {
+    Key old = x->getKey();
+    visit(*this, [&](auto &e) { e.decreaseKey(x, k); });
+    // A rejected call leaves the key alone, and a call with the current key changes nothing
+    if (!(x->getKey() == old))
+        ++keyChanges;
+    sample();
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::increaseKey(handle x, Key k) {
+    Key old = x->getKey();
+    visit(*this, [&](auto &e) { e.increaseKey(x, k); });
+    if (!(x->getKey() == old))
+        ++keyChanges;
+    sample();
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::erase(handle x) {
+    visit(*this, [&](auto &e) { e.erase(x); });
+    sample();
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::meld(AdaptiveHeap &&other) {
+    if (&other == this) return;
+
+    if (other.engine != engine)
+        other.migrate(engine);
+    switch (engine) {
+        case EngineKind::Dary:
+            dary.meld(std::move(other.dary));
+            break;
+        case EngineKind::Fibonacci:
+            fib.meld(std::move(other.fib));
+            break;
+        default:
+            pairing.meld(std::move(other.pairing));
+            break;
+    }
+    ++melds;
+    sample();
+}
+
+template<typename Key, typename Value, typename Compare>
+Node<Value, Key> *AdaptiveHeap<Key, Value, Compare>::extractMin() {
+    handle minptr = visit(*this, [](auto &e) { return e.extractMin(); });
+    sample();
+    return minptr;
+}
+
+template<typename Key, typename Value, typename Compare>
+std::vector<typename AdaptiveHeap<Key, Value, Compare>::handle>
+AdaptiveHeap<Key, Value, Compare>::topK(int k) const {
+    return visit(*this, [&](const auto &e) { return e.topK(k); });
+}
+
+template<typename Key, typename Value, typename Compare>
+Node<Value, Key> *AdaptiveHeap<Key, Value, Compare>::displayMinimum() {
+    return visit(*this, [](auto &e) { return e.displayMinimum(); });
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::modifyKey(Key currentNodeKey, Key new_k) {
+    handle x = find(currentNodeKey);
+    visit(*this, [&](auto &e) { e.modifyKey(currentNodeKey, new_k); });
+    // A missing node, an unchanged key or a taken key is rejected and leaves x as it was
+    if (x != nullptr && !(x->getKey() == currentNodeKey))
+        ++keyChanges;
+    sample();
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::deleteNode(Key key) {
+    visit(*this, [&](auto &e) { e.deleteNode(key); });
+    sample();
+}
+
+template<typename Key, typename Value, typename Compare>
+void AdaptiveHeap<Key, Value, Compare>::display() {
+    static const char *const names[] = {"D-ary heap", "Pairing heap", "Fibonacci heap"};
+    std::cout << "Engine: " << names[static_cast<int>(engine)] << std::endl;
+    visit(*this, [](auto &e) { e.display(); });
+}
+
+template<typename Key, typename Value, typename Compare>
+Node<Value, Key> *AdaptiveHeap<Key, Value, Compare>::find(Key key) const {
+    return visit(*this, [&](const auto &e) { return e.find(key); });
+}
+
+template<typename Key, typename Value, typename Compare>
+bool AdaptiveHeap<Key, Value, Compare>::isEmpty() {
+    return visit(*this, [](auto &e) { return e.isEmpty(); });
+}
+
+template<typename Key, typename Value, typename Compare>
+int AdaptiveHeap<Key, Value, Compare>::getSize() {
+    return visit(*this, [](auto &e) { return e.getSize(); });
+}
+
+#endif // ADAPTIVEHEAP_H
@@ -0,0 +1,566 @@
+#ifndef BINOMIALHEAP_H
+#define BINOMIALHEAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
+#include "error_handler.h"
+
+/**
+ * @class BinomialHeap
+ * @brief Represents a binomial heap whose every operation is bounded in the worst case.
+ *
+ * The heap keeps at most one binomial tree per degree and restores that shape
+ * eagerly, so no call ever pays for work deferred by earlier ones: insert,
+ * extractMin, decreaseKey, increaseKey and erase are O(log n) in the worst case.
+ * This is the engine for queues with a per-operation latency bound, where the
+ * amortized engines can stall on one large consolidation.
+ *
+ * Trees are built from cells kept in one array and addressed by index. A cell
+ * holds a key and a node, and sifting swaps the contents of a cell and its
+ * parent, so every node keeps the index of its current cell in slot and handles
+ * stay valid. Once reserve() has sized the storage for the largest expected
+ * heap, no operation reallocates.
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Compare Strict weak ordering on keys; the node that compares first is the minimum.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key>,
+    template<typename> class Allocator = NodePool>
+class BinomialHeap : public KeyedHeap<BinomialHeap<Key, Value, Compare, Allocator>, Key, Value, 10, Compare> {
+private:
+    using Keyed = KeyedHeap<BinomialHeap, Key, Value, 10, Compare>;
+    friend Keyed;
+
+    /**
+     * @brief A cell of a binomial tree. Links are indices into cells, -1 meaning none.
+     */
+    struct Cell {
+        Key key; ///< Copy of the key of the node held by the cell.
+        Node<Value, Key> *item; ///< The node held by the cell, or null while the cell is free.
+        int parent; ///< Parent cell.
+        int child; ///< Child of the highest degree.
+        int sibling; ///< Next root in increasing degree, or next child in decreasing degree.
+        int deg; ///< Degree of the tree rooted here.
+    };
+
+    std::vector<Cell> cells; ///< Storage for every cell.
+    std::vector<int> freeCells; ///< Released cell indices waiting to be reused.
+    int head; ///< First root of the root list, ordered by increasing degree, or -1.
+    int min; ///< Root holding the minimum key, or -1.
+    int size; ///< Number of nodes in the heap.
+    KeyIndex<Key, Value> index; ///< Key to node index backing find().
+    error_handler *handler;
+    Compare comp; ///< Key ordering; comp(a, b) means a belongs above b.
+    Allocator<Node<Value, Key> > allocator; ///< Storage for every node created through this heap.
+
+    /**
+     * @brief Puts a node into a new single-cell tree and records the cell in the node's slot.
+     *
+     * @param x The node to hold.
+     * @return int The index of the new cell.
+     */
+    int makeCell(Node<Value, Key> *x);
+
+    /**
+     * @brief Swaps the contents of two cells and fixes up the slots of their nodes.
+     */
+    void swapContents(int a, int b);
+
+    /**
+     * @brief Unites two root lists into one with at most one tree per degree, in O(log n).
+     *
+     * @param a The first root list, may be -1.
+     * @param b The second root list, may be -1.
+     * @return int The head of the united root list.
+     */
+    int unite(int a, int b);
+
+    /**
+     * @brief Scans the root list for the minimum root.
+     */
+    void findMin();
+
+    /**
+     * @brief Takes a root out of the root list and unites its children back in.
+     *
+     * @param r The root to take out. Its cell is released.
+     */
+    void removeRoot(int r);
+
+public:
+    /**
+     * @brief Stable reference to a node in the heap.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
+    /**
+     * @brief Constructs a new, empty binomial heap.
+     */
+    BinomialHeap(error_handler *handler);
+
+    /**
+     * @brief Destroys the heap and releases every node still in it.
+     */
+    ~BinomialHeap();
+
+    BinomialHeap(const BinomialHeap &) = delete;
+    BinomialHeap &operator=(const BinomialHeap &) = delete;
+
+    /**
+     * @brief Sizes the cell storage and the key index for a number of nodes.
+     *
+     * Up to that many nodes, no later operation reallocates or rehashes.
+     *
+     * @param n The largest number of nodes the heap is expected to hold.
+     */
+    void reserve(int n);
+
+    /**
+     * @brief Allocates a node from the heap's allocator without inserting it.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The new node.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the heap to the allocator.
+     *
+     * @param x The node to release. Null is ignored.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the heap.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the heap.
+     *
+     * @param x The node to be inserted.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the heap.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Lowers the key of a node and sifts it up its tree.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be greater than the current one.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node by taking it out and inserting it again.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be less than the current one.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the heap without searching for it.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another heap into this one.
+     *
+     * The smaller cell array is copied over, so this costs O(min(n, m)) like the
+     * index merge, plus O(log n) to unite the root lists.
+     *
+     * @param other The heap to meld into this one. It is left empty.
+     */
+    void meld(BinomialHeap &&other);
+
+    /**
+     * @brief Extracts the minimum node from the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the heap.
+     *
+     * @param k The number of nodes to list.
+     * @return std::vector<handle> Up to k nodes in increasing key order.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the minimum node in the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Displays the structure of the heap.
+     */
+    void display();
+
+    /**
+     * @brief Checks if the heap is empty.
+     *
+     * @return true If the heap is empty.
+     * @return false If the heap is not empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the heap.
+     *
+     * @return int The number of nodes in the heap.
+     */
+    int getSize();
+};
+
+// Implementation of the BinomialHeap template class
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+BinomialHeap<Key, Value, Compare, Allocator>::BinomialHeap(error_handler *handler)
+    : head(-1), min(-1), size(0), handler(handler) {}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+BinomialHeap<Key, Value, Compare, Allocator>::~BinomialHeap() {
+    clear();
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::reserve(int n) {
+    cells.reserve(n);
+    freeCells.reserve(n);
+    index.reserve(n);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename BinomialHeap<Key, Value, Compare, Allocator>::handle
+BinomialHeap<Key, Value, Compare, Allocator>::createNode(Value Name, Key key) {
+    return allocator.allocate(Name, key);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::destroyNode(handle x) {
+    allocator.deallocate(x);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::clear() {
+    if constexpr (Allocator<Node<Value, Key> >::bulk_release && std::is_trivially_destructible<Node<Value, Key> >::value) {
+        allocator.release();
+    } else {
+        for (const Cell &cell: cells)
+            allocator.deallocate(cell.item);
+    }
+    cells.clear();
+    freeCells.clear();
+    head = min = -1;
+    index.clear();
+    size = 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int BinomialHeap<Key, Value, Compare, Allocator>::makeCell(Node<Value, Key> *x) {
+    int i;
+    if (!freeCells.empty()) {
+        i = freeCells.back();
+        freeCells.pop_back();
+        cells[i] = {x->key, x, -1, -1, -1, 0};
+    } else {
+        i = static_cast<int>(cells.size());
+        cells.push_back({x->key, x, -1, -1, -1, 0});
+    }
+    x->slot = i;
+    return i;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::swapContents(int a, int b) {
+    std::swap(cells[a].key, cells[b].key);
+    std::swap(cells[a].item, cells[b].item);
+    cells[a].item->slot = a;
+    cells[b].item->slot = b;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int BinomialHeap<Key, Value, Compare, Allocator>::unite(int a, int b) {
+    // Merge the two root lists by degree
+    int first = -1, last = -1;
+    while (a != -1 || b != -1) {
+        int next;
+        if (b == -1 || (a != -1 && cells[a].deg <= cells[b].deg)) {
+            next = a;
+            a = cells[a].sibling;
+        } else {
+            next = b;
+            b = cells[b].sibling;
+        }
+        if (last == -1)
+            first = next;
+        else
+            cells[last].sibling = next;
+        last = next;
+    }
+    if (last != -1)
+        cells[last].sibling = -1;
+
+    // Link trees of equal degree, carrying upwards like binary addition
+    int prev = -1, x = first;
+    while (x != -1 && cells[x].sibling != -1) {
+        int next = cells[x].sibling;
+        if (cells[x].deg != cells[next].deg ||
+            (cells[next].sibling != -1 && cells[cells[next].sibling].deg == cells[x].deg)) {
+            prev = x;
+            x = next;
+            continue;
+        }
+        int winner = x, loser = next;
+        if (comp(cells[next].key, cells[x].key))
+            std::swap(winner, loser);
+        if (winner == x) {
+            cells[x].sibling = cells[next].sibling;
+        } else if (prev == -1) {
+            first = next;
+        } else {
+            cells[prev].sibling = next;
+        }
+        cells[loser].parent = winner;
+        cells[loser].sibling = cells[winner].child;
+        cells[winner].child = loser;
+        ++cells[winner].deg;
+        x = winner;
+    }
+    return first;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::findMin() {
+    min = head;
+    for (int r = head; r != -1; r = cells[r].sibling) {
+        if (comp(cells[r].key, cells[min].key))
+            min = r;
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::removeRoot(int r) {
+    if (head == r) {
+        head = cells[r].sibling;
+    } else {
+        int prev = head;
+        while (cells[prev].sibling != r)
+            prev = cells[prev].sibling;
+        cells[prev].sibling = cells[r].sibling;
+    }
+
+    // The children are in decreasing degree; reverse them into a root list
+    int children = -1;
+    for (int c = cells[r].child; c != -1;) {
+        int next = cells[c].sibling;
+        cells[c].parent = -1;
+        cells[c].sibling = children;
+        children = c;
+        c = next;
+    }
+    head = unite(head, children);
+    cells[r].item = nullptr;
+    freeCells.push_back(r);
+    findMin();
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename BinomialHeap<Key, Value, Compare, Allocator>::handle
+BinomialHeap<Key, Value, Compare, Allocator>::insert(Node<Value, Key> *x) {
+    head = unite(head, makeCell(x));
+    findMin();
+    index.insert(x);
+    ++size;
+    handler->verbose_log(10, "Insert function called.");
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename BinomialHeap<Key, Value, Compare, Allocator>::handle
+BinomialHeap<Key, Value, Compare, Allocator>::insert(Value Name, Key key) {
+    return insert(createNode(Name, key));
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::decreaseKey(handle x, Key k) {
+    if (comp(x->key, k)) {
+        handler->e_log(10, "New key is greater than the current key.\n");
+        return;
+    }
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+
+    int i = x->slot;
+    cells[i].key = k;
+    while (cells[i].parent != -1 && comp(k, cells[cells[i].parent].key)) {
+        swapContents(i, cells[i].parent);
+        i = cells[i].parent;
+    }
+    if (cells[i].parent == -1 && comp(k, cells[min].key))
+        min = i;
+    handler->verbose_log(10, "DecreaseKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::increaseKey(handle x, Key k) {
+    if (comp(k, x->key)) {
+        handler->e_log(10, "New key is less than the current key.\n");
+        return;
+    }
+    erase(x);
+    x->key = k;
+    insert(x);
+    handler->verbose_log(10, "IncreaseKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::erase(handle x) {
+    // Sift the node to the root of its tree regardless of keys, then take the root out
+    int i = x->slot;
+    while (cells[i].parent != -1) {
+        swapContents(i, cells[i].parent);
+        i = cells[i].parent;
+    }
+    removeRoot(i);
+    index.erase(x);
+    --size;
+    handler->verbose_log(10, "Erase function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::meld(BinomialHeap &&other) {
+    if (&other == this || other.head == -1) return;
+
+    if (cells.size() < other.cells.size()) {
+        cells.swap(other.cells);
+        freeCells.swap(other.freeCells);
+        std::swap(head, other.head);
+    }
+    int offset = static_cast<int>(cells.size());
+    for (Cell cell: other.cells) {
+        if (cell.parent != -1) cell.parent += offset;
+        if (cell.child != -1) cell.child += offset;
+        if (cell.sibling != -1) cell.sibling += offset;
+        if (cell.item != nullptr) cell.item->slot += offset;
+        cells.push_back(cell);
+    }
+    for (int i: other.freeCells)
+        freeCells.push_back(i + offset);
+    head = unite(head, other.head == -1 ? -1 : other.head + offset);
+    findMin();
+
+    size += other.size;
+    index.merge(other.index);
+    allocator.merge(other.allocator);
+    other.cells.clear();
+    other.freeCells.clear();
+    other.head = other.min = -1;
+    other.size = 0;
+    handler->verbose_log(10, "Meld function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *BinomialHeap<Key, Value, Compare, Allocator>::extractMin() {
+    if (min == -1) {
+        handler->e_log(Keyed::notFound);
+        return nullptr;
+    }
+    Node<Value, Key> *minptr = cells[min].item;
+    erase(minptr);
+    handler->verbose_log(10, "ExtractMin function called.");
+    return minptr;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+std::vector<typename BinomialHeap<Key, Value, Compare, Allocator>::handle>
+BinomialHeap<Key, Value, Compare, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    if (head == -1 || k <= 0) return result;
+    auto later = [this](int a, int b) { return comp(cells[b].key, cells[a].key); };
+
+    std::vector<int> candidates;
+    for (int r = head; r != -1; r = cells[r].sibling)
+        candidates.push_back(r);
+    std::make_heap(candidates.begin(), candidates.end(), later);
+
+    result.reserve(std::min(k, size));
+    while (static_cast<int>(result.size()) < k && !candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), later);
+        int v = candidates.back();
+        candidates.pop_back();
+        result.push_back(cells[v].item);
+
+        for (int c = cells[v].child; c != -1; c = cells[c].sibling) {
+            candidates.push_back(c);
+            std::push_heap(candidates.begin(), candidates.end(), later);
+        }
+    }
+    return result;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *BinomialHeap<Key, Value, Compare, Allocator>::displayMinimum() {
+    return min == -1 ? nullptr : cells[min].item;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void BinomialHeap<Key, Value, Compare, Allocator>::display() {
+    handler->verbose_log(10, "Display Function called.");
+    if (head == -1) {
+        handler->e_log(Keyed::emptyHeap);
+        return;
+    }
+
+    std::function<void(int, int)> displayCell = [&](int v, int level) {
+        for (int i = 0; i < level; ++i) std::cout << "  ";
+        std::cout << "Key: " << cells[v].key << ", Name: " << cells[v].item->getName() << ", Degree: " << cells[v].deg << std::endl;
+        for (int c = cells[v].child; c != -1; c = cells[c].sibling)
+            displayCell(c, level + 1);
+    };
+
+    for (int r = head; r != -1; r = cells[r].sibling)
+        displayCell(r, 0);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+bool BinomialHeap<Key, Value, Compare, Allocator>::isEmpty() {
+    return size == 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int BinomialHeap<Key, Value, Compare, Allocator>::getSize() {
+    return size;
+}
+
+#endif // BINOMIALHEAP_H
@@ -0,0 +1,41 @@
+#ifndef BITOPS_H
+#define BITOPS_H
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Number of bits needed to represent a value, i.e. one past its highest set bit.
+ *
+ * @param x The value to measure.
+ * @return int 0 for 0, otherwise floor(log2(x)) + 1.
+ */
+inline int bitWidth(unsigned long long x) {
+    if (x == 0) return 0;
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return static_cast<int>(index) + 1;
+#else
+    return 64 - __builtin_clzll(x);
+#endif
+}
+
+/**
+ * @brief Index of the lowest set bit (find-first-set).
+ *
+ * @param x The value to scan, which must not be 0.
+ * @return int The position of the lowest set bit.
+ */
+inline int lowestSetBit(unsigned long long x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+#endif // BITOPS_H
@@ -0,0 +1,441 @@
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "BitOps.h"
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
+#include "error_handler.h"
+
+/**
+ * @class BucketQueue
+ * @brief Represents a bucket queue for integer keys in a small, fixed range.
+ *
+ * There is one bucket per key in [0, Range). Each bucket is an intrusive ring
+ * of nodes linked through left/right. A two-level bitmap of non-empty buckets
+ * (one summary word over up to 64 words of 64 bits) lets the minimum be found
+ * with two find-first-set instructions. Insert, extractMin, key changes and
+ * erase are all O(1), and no trees are built. Keys outside the range are rejected.
+ * The buckets double as the key index: find() just reads buckets[key].
+ *
+ * @tparam Key An integral key type.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Range One past the largest admissible key, at most 4096.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, int Range = 1024, template<typename> class Allocator = NodePool>
+class BucketQueue : public KeyedHeap<BucketQueue<Key, Value, Range, Allocator>, Key, Value, 11> {
+private:
+    using Keyed = KeyedHeap<BucketQueue, Key, Value, 11>;
+    friend Keyed;
+
+    static_assert(std::is_integral<Key>::value, "BucketQueue needs integral keys");
+    static_assert(Range > 0 && Range <= 64 * 64, "BucketQueue tracks its buckets in a two-level 64-bit bitmap");
+
+    static constexpr int wordCount = (Range + 63) / 64;
+
+    std::vector<Node<Value, Key> *> buckets; ///< One ring per key; null when the bucket is empty.
+    unsigned long long words[wordCount]; ///< Bit b % 64 of word b / 64 is set when bucket b has nodes.
+    unsigned long long summary; ///< Bit w is set when word w is non-zero.
+    int size; ///< Number of nodes in the queue.
+    error_handler *handler;
+    Allocator<Node<Value, Key> > allocator; ///< Storage for every node created through this queue.
+
+    /**
+     * @brief Adds a node to the ring of its key and marks the bucket non-empty.
+     */
+    void push(Node<Value, Key> *x);
+
+    /**
+     * @brief Unlinks a node from its ring and clears the bucket's bit if it empties.
+     */
+    void pop(Node<Value, Key> *x);
+
+    /**
+     * @brief Index of the first non-empty bucket; the queue must not be empty.
+     */
+    int firstBucket() const;
+
+    /**
+     * @brief Checks that a key lies in [0, Range), logging an error if not.
+     */
+    bool admissible(Key key);
+
+public:
+    /**
+     * @brief Stable reference to a node in the queue.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the queue.
+    using value_type = Value; ///< The type of data stored in the queue nodes.
+
+    /**
+     * @brief Constructs a new, empty bucket queue.
+     */
+    BucketQueue(error_handler *handler);
+
+    /**
+     * @brief Destroys the queue and releases every node still in it.
+     */
+    ~BucketQueue();
+
+    BucketQueue(const BucketQueue &) = delete;
+    BucketQueue &operator=(const BucketQueue &) = delete;
+
+    /**
+     * @brief Allocates a node from the queue's allocator without inserting it.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the queue to the allocator.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the queue.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the queue.
+     *
+     * @param x The node to be inserted.
+     * @return handle The node, or nullptr if its key is outside [0, Range).
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the queue.
+     *
+     * @return handle The new node, or nullptr if the key was rejected.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Lowers the key of a node by moving it to its new bucket.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node by moving it to its new bucket, as long as it stays in range.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the queue without searching for it.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another bucket queue into this one by splicing bucket rings, O(Range / 64 + buckets used).
+     *
+     * @param other The queue to meld into this one. It is left empty.
+     */
+    void meld(BucketQueue &&other);
+
+    /**
+     * @brief Extracts the minimum node from the queue.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the queue, walking set bits upwards.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the minimum node in the queue.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Displays the contents of every non-empty bucket.
+     */
+    void display();
+
+    /**
+     * @brief Finds a node with a specific key in the queue.
+     */
+    Node<Value, Key> *find(Key key) const;
+
+    /**
+     * @brief Checks if the queue is empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the queue.
+     */
+    int getSize();
+};
+
+// Implementation of the BucketQueue template class
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+BucketQueue<Key, Value, Range, Allocator>::BucketQueue(error_handler *handler)
+    : buckets(Range, nullptr), words(), summary(0), size(0), handler(handler) {}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+BucketQueue<Key, Value, Range, Allocator>::~BucketQueue() {
+    clear();
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+typename BucketQueue<Key, Value, Range, Allocator>::handle
+BucketQueue<Key, Value, Range, Allocator>::createNode(Value Name, Key key) {
+    return allocator.allocate(Name, key);
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+void BucketQueue<Key, Value, Range, Allocator>::destroyNode(handle x) {
+    allocator.deallocate(x);
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+void BucketQueue<Key, Value, Range, Allocator>::clear() {
+    if constexpr (Allocator<Node<Value, Key> >::bulk_release && std::is_trivially_destructible<Node<Value, Key> >::value) {
+        allocator.release();
+    } else {
+        while (size > 0) {
+            Node<Value, Key> *x = buckets[firstBucket()];
+            pop(x);
+            --size;
+            allocator.deallocate(x);
+        }
+    }
+    std::fill(buckets.begin(), buckets.end(), nullptr);
+    std::fill(words, words + wordCount, 0ULL);
+    summary = 0;
+    size = 0;
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+void BucketQueue<Key, Value, Range, Allocator>::push(Node<Value, Key> *x) {
+    int b = static_cast<int>(x->key);
+    Node<Value, Key> *&head = buckets[b];
+    if (head == nullptr) {
+        x->left = x->right = x;
+        head = x;
+        words[b / 64] |= 1ULL << (b % 64);
+        summary |= 1ULL << (b / 64);
+    } else {
+        x->right = head;
+        x->left = head->left;
+        head->left->right = x;
+        head->left = x;
+    }
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+void BucketQueue<Key, Value, Range, Allocator>::pop(Node<Value, Key> *x) {
+    int b = static_cast<int>(x->key);
+    Node<Value, Key> *&head = buckets[b];
+    if (x->right == x) {
+        head = nullptr;
+        words[b / 64] &= ~(1ULL << (b % 64));
+        if (words[b / 64] == 0)
+            summary &= ~(1ULL << (b / 64));
+    } else {
+        x->left->right = x->right;
+        x->right->left = x->left;
+        if (head == x)
+            head = x->right;
+    }
+    x->left = x->right = nullptr;
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+int BucketQueue<Key, Value, Range, Allocator>::firstBucket() const {
+    int w = lowestSetBit(summary);
+    return w * 64 + lowestSetBit(words[w]);
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+bool BucketQueue<Key, Value, Range, Allocator>::admissible(Key key) {
+    if constexpr (std::is_signed<Key>::value) {
+        if (key < 0) {
+            handler->e_log(11, "Keys must be non-negative.\n");
+            return false;
+        }
+    }
+    if (key >= static_cast<Key>(Range)) {
+        handler->e_log(11, "Key is outside the queue's range.\n");
+        return false;
+    }
+    return true;
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+typename BucketQueue<Key, Value, Range, Allocator>::handle
+BucketQueue<Key, Value, Range, Allocator>::insert(Node<Value, Key> *x) {
+    if (!admissible(x->key))
+        return nullptr;
+    push(x);
+    ++size;
+    handler->verbose_log(11, "Insert function called.");
+    return x;
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+typename BucketQueue<Key, Value, Range, Allocator>::handle
+BucketQueue<Key, Value, Range, Allocator>::insert(Value Name, Key key) {
+    if (!admissible(key))
+        return nullptr;
+    return insert(createNode(Name, key));
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+void BucketQueue<Key, Value, Range, Allocator>::decreaseKey(handle x, Key k) {
+    if (k > x->key) {
+        handler->e_log(11, "New key is greater than the current key.\n");
+        return;
+    }
+    if (!admissible(k))
+        return;
+    pop(x);
+    x->key = k;
+    push(x);
+    handler->verbose_log(11, "DecreaseKey function called");
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+void BucketQueue<Key, Value, Range, Allocator>::increaseKey(handle x, Key k) {
+    if (k < x->key) {
+        handler->e_log(11, "New key is less than the current key.\n");
+        return;
+    }
+    if (!admissible(k))
+        return;
+    pop(x);
+    x->key = k;
+    push(x);
+    handler->verbose_log(11, "IncreaseKey function called");
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+void BucketQueue<Key, Value, Range, Allocator>::erase(handle x) {
+    pop(x);
+    --size;
+    handler->verbose_log(11, "Erase function called");
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+void BucketQueue<Key, Value, Range, Allocator>::meld(BucketQueue &&other) {
+    if (&other == this) return;
+
+    for (int w = 0; w < wordCount; w++) {
+        for (unsigned long long bits = other.words[w]; bits != 0; bits &= bits - 1) {
+            int b = w * 64 + lowestSetBit(bits);
+            Node<Value, Key> *theirs = other.buckets[b];
+            Node<Value, Key> *&ours = buckets[b];
+            if (ours == nullptr) {
+                ours = theirs;
+            } else {
+                Node<Value, Key> *ourTail = ours->left, *theirTail = theirs->left;
+                ourTail->right = theirs;
+                theirs->left = ourTail;
+                theirTail->right = ours;
+                ours->left = theirTail;
+            }
+            other.buckets[b] = nullptr;
+        }
+        words[w] |= other.words[w];
+        other.words[w] = 0;
+    }
+    summary |= other.summary;
+    other.summary = 0;
+
+    size += other.size;
+    allocator.merge(other.allocator);
+    other.size = 0;
+    handler->verbose_log(11, "Meld function called.");
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+Node<Value, Key> *BucketQueue<Key, Value, Range, Allocator>::extractMin() {
+    if (size == 0) {
+        handler->e_log(Keyed::notFound);
+        return nullptr;
+    }
+    Node<Value, Key> *minptr = buckets[firstBucket()];
+    erase(minptr);
+    handler->verbose_log(11, "ExtractMin function called.");
+    return minptr;
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+std::vector<typename BucketQueue<Key, Value, Range, Allocator>::handle>
+BucketQueue<Key, Value, Range, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    for (int w = 0; w < wordCount && static_cast<int>(result.size()) < k; w++) {
+        for (unsigned long long bits = words[w]; bits != 0 && static_cast<int>(result.size()) < k; bits &= bits - 1) {
+            Node<Value, Key> *head = buckets[w * 64 + lowestSetBit(bits)];
+            Node<Value, Key> *x = head;
+            do {
+                result.push_back(x);
+                x = x->right;
+            } while (x != head && static_cast<int>(result.size()) < k);
+        }
+    }
+    return result;
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+Node<Value, Key> *BucketQueue<Key, Value, Range, Allocator>::displayMinimum() {
+    return size == 0 ? nullptr : buckets[firstBucket()];
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+void BucketQueue<Key, Value, Range, Allocator>::display() {
+    handler->verbose_log(11, "Display Function called.");
+    if (size == 0) {
+        handler->e_log(Keyed::emptyHeap);
+        return;
+    }
+    for (int w = 0; w < wordCount; w++) {
+        for (unsigned long long bits = words[w]; bits != 0; bits &= bits - 1) {
+            int b = w * 64 + lowestSetBit(bits);
+            std::cout << "Bucket " << b << ":" << std::endl;
+            Node<Value, Key> *x = buckets[b];
+            do {
+                std::cout << "  Name: " << x->getName() << std::endl;
+                x = x->right;
+            } while (x != buckets[b]);
+        }
+    }
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+Node<Value, Key> *BucketQueue<Key, Value, Range, Allocator>::find(Key key) const {
+    handler->verbose_log(11, "Search function Called.");
+    if constexpr (std::is_signed<Key>::value) {
+        if (key < 0) return nullptr;
+    }
+    if (key >= static_cast<Key>(Range)) return nullptr;
+    return buckets[static_cast<int>(key)];
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+bool BucketQueue<Key, Value, Range, Allocator>::isEmpty() {
+    return size == 0;
+}
+
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+int BucketQueue<Key, Value, Range, Allocator>::getSize() {
+    return size;
+}
+
+#endif // BUCKETQUEUE_H
@@ -0,0 +1,491 @@
+#ifndef CALENDARQUEUE_H
+#define CALENDARQUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "BitOps.h"
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
+#include "error_handler.h"
+
+/**
+ * @class CalendarQueue
+ * @brief Represents a calendar queue for time-like, non-negative keys.
+ *
+ * Time is split into days of a fixed width. A key falls on day key / width
+ * and is filed in bucket day % bucketCount, where each bucket is a sorted list
+ * linked through left/right. extractMin walks the calendar from the current day
+ * and takes the first node found that falls on the day being visited. When the
+ * number of nodes doubles or halves, the bucket count follows and the day width
+ * is re-estimated from the average spacing of the keys. This keeps a few nodes
+ * per bucket, so insert and extractMin are O(1) on average for the usual
+ * event-simulation key distributions.
+ *
+ * Keys below the current day move the day back, so keys need not be monotone.
+ *
+ * @tparam Key An arithmetic key type; negative keys are rejected.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, template<typename> class Allocator = NodePool>
+class CalendarQueue : public KeyedHeap<CalendarQueue<Key, Value, Allocator>, Key, Value, 12> {
+private:
+    using Keyed = KeyedHeap<CalendarQueue, Key, Value, 12>;
+    friend Keyed;
+
+    static_assert(std::is_arithmetic<Key>::value, "CalendarQueue needs arithmetic keys");
+
+    static constexpr int minBuckets = 2; ///< The calendar never shrinks below this many buckets.
+
+    std::vector<Node<Value, Key> *> buckets; ///< Sorted lists of nodes; the count is a power of two.
+    Key width; ///< Width of one day.
+    long long day; ///< Current day; no node falls on an earlier one.
+    int size; ///< Number of nodes in the queue.
+    KeyIndex<Key, Value> index; ///< Key to node index backing find().
+    error_handler *handler;
+    Allocator<Node<Value, Key> > allocator; ///< Storage for every node created through this queue.
+    std::vector<Node<Value, Key> *> scratch; ///< Scratch list reused by resize().
+
+    /**
+     * @brief Day a key falls on.
+     */
+    long long dayOf(Key key) const;
+
+    /**
+     * @brief Files a node in the sorted list of its bucket and moves the current day back if needed.
+     */
+    void push(Node<Value, Key> *x);
+
+    /**
+     * @brief Unlinks a node from its bucket.
+     */
+    void pop(Node<Value, Key> *x);
+
+    /**
+     * @brief Finds the minimum node, advancing the current day to the day it falls on.
+     */
+    Node<Value, Key> *locateMin();
+
+    /**
+     * @brief Rebuilds the calendar with a new bucket count and a re-estimated day width.
+     */
+    void resize(int bucketCount);
+
+    /**
+     * @brief Checks that a key is non-negative, logging an error if not.
+     */
+    bool admissible(Key key);
+
+public:
+    /**
+     * @brief Stable reference to a node in the queue.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the queue.
+    using value_type = Value; ///< The type of data stored in the queue nodes.
+
+    /**
+     * @brief Constructs a new, empty calendar queue.
+     */
+    CalendarQueue(error_handler *handler);
+
+    /**
+     * @brief Destroys the queue and releases every node still in it.
+     */
+    ~CalendarQueue();
+
+    CalendarQueue(const CalendarQueue &) = delete;
+    CalendarQueue &operator=(const CalendarQueue &) = delete;
+
+    /**
+     * @brief Allocates a node from the queue's allocator without inserting it.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the queue to the allocator.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the queue.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the queue.
+     *
+     * @param x The node to be inserted.
+     * @return handle The node, or nullptr if its key is negative.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the queue.
+     *
+     * @return handle The new node, or nullptr if the key was rejected.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Lowers the key of a node by refiling it, as long as it stays non-negative.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node by refiling it.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the queue without searching for it.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another calendar queue into this one.
+     *
+     * The nodes of the smaller queue are refiled into the larger one's calendar, O(min(n, m)).
+     *
+     * @param other The queue to meld into this one. It is left empty.
+     */
+    void meld(CalendarQueue &&other);
+
+    /**
+     * @brief Extracts the minimum node from the queue.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the queue.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the minimum node in the queue.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Displays the contents of every non-empty bucket.
+     */
+    void display();
+
+    /**
+     * @brief Checks if the queue is empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the queue.
+     */
+    int getSize();
+};
+
+// Implementation of the CalendarQueue template class
+
+template<typename Key, typename Value, template<typename> class Allocator>
+CalendarQueue<Key, Value, Allocator>::CalendarQueue(error_handler *handler)
+    : buckets(minBuckets, nullptr), width(1), day(0), size(0), handler(handler) {}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+CalendarQueue<Key, Value, Allocator>::~CalendarQueue() {
+    clear();
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+typename CalendarQueue<Key, Value, Allocator>::handle
+CalendarQueue<Key, Value, Allocator>::createNode(Value Name, Key key) {
+    return allocator.allocate(Name, key);
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void CalendarQueue<Key, Value, Allocator>::destroyNode(handle x) {
+    allocator.deallocate(x);
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void CalendarQueue<Key, Value, Allocator>::clear() {
+    if constexpr (Allocator<Node<Value, Key> >::bulk_release && std::is_trivially_destructible<Node<Value, Key> >::value) {
+        allocator.release();
+    } else {
+        for (Node<Value, Key> *x: buckets) {
+            while (x != nullptr) {
+                Node<Value, Key> *next = x->right;
+                allocator.deallocate(x);
+                x = next;
+            }
+        }
+    }
+    buckets.assign(minBuckets, nullptr);
+    width = 1;
+    day = 0;
+    index.clear();
+    size = 0;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+long long CalendarQueue<Key, Value, Allocator>::dayOf(Key key) const {
+    return static_cast<long long>(key / width);
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void CalendarQueue<Key, Value, Allocator>::push(Node<Value, Key> *x) {
+    long long d = dayOf(x->key);
+    int b = static_cast<int>(d & static_cast<long long>(buckets.size() - 1));
+    x->slot = b;
+
+    // Equal keys keep their arrival order
+    Node<Value, Key> *prev = nullptr, *next = buckets[b];
+    while (next != nullptr && !(x->key < next->key)) {
+        prev = next;
+        next = next->right;
+    }
+    x->left = prev;
+    x->right = next;
+    if (prev != nullptr)
+        prev->right = x;
+    else
+        buckets[b] = x;
+    if (next != nullptr)
+        next->left = x;
+
+    if (size == 0 || d < day)
+        day = d;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void CalendarQueue<Key, Value, Allocator>::pop(Node<Value, Key> *x) {
+    if (x->left != nullptr)
+        x->left->right = x->right;
+    else
+        buckets[x->slot] = x->right;
+    if (x->right != nullptr)
+        x->right->left = x->left;
+    x->left = x->right = nullptr;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+Node<Value, Key> *CalendarQueue<Key, Value, Allocator>::locateMin() {
+    long long mask = static_cast<long long>(buckets.size() - 1);
+    for (long long d = day; d < day + static_cast<long long>(buckets.size()); d++) {
+        Node<Value, Key> *head = buckets[d & mask];
+        if (head != nullptr && dayOf(head->key) == d) {
+            day = d;
+            return head;
+        }
+    }
+
+    // A whole year went by without a hit, so the keys are sparse: search the heads directly
+    Node<Value, Key> *lowest = nullptr;
+    for (Node<Value, Key> *head: buckets) {
+        if (head != nullptr && (lowest == nullptr || head->key < lowest->key))
+            lowest = head;
+    }
+    day = dayOf(lowest->key);
+    return lowest;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void CalendarQueue<Key, Value, Allocator>::resize(int bucketCount) {
+    scratch.clear();
+    for (Node<Value, Key> *x: buckets) {
+        for (; x != nullptr; x = x->right)
+            scratch.push_back(x);
+    }
+
+    // Three times the average spacing of the keys, so a day holds about three nodes
+    if (scratch.size() >= 2) {
+        auto bounds = std::minmax_element(scratch.begin(), scratch.end(),
+                                          [](Node<Value, Key> *a, Node<Value, Key> *b) { return a->key < b->key; });
+        Key spread = (*bounds.second)->key - (*bounds.first)->key;
+        if (spread > 0) {
+            Key estimate = static_cast<Key>(3 * spread / static_cast<Key>(scratch.size() - 1));
+            width = estimate > 0 ? estimate : static_cast<Key>(1);
+        }
+    }
+
+    buckets.assign(bucketCount, nullptr);
+    int count = size;
+    size = 0;
+    for (Node<Value, Key> *x: scratch) {
+        push(x);
+        ++size;
+    }
+    size = count;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+bool CalendarQueue<Key, Value, Allocator>::admissible(Key key) {
+    if constexpr (std::is_signed<Key>::value) {
+        if (key < 0) {
+            handler->e_log(12, "Keys must be non-negative.\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+typename CalendarQueue<Key, Value, Allocator>::handle
+CalendarQueue<Key, Value, Allocator>::insert(Node<Value, Key> *x) {
+    if (!admissible(x->key))
+        return nullptr;
+    push(x);
+    index.insert(x);
+    ++size;
+    if (size > 2 * static_cast<int>(buckets.size()))
+        resize(2 * static_cast<int>(buckets.size()));
+    handler->verbose_log(12, "Insert function called.");
+    return x;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+typename CalendarQueue<Key, Value, Allocator>::handle
+CalendarQueue<Key, Value, Allocator>::insert(Value Name, Key key) {
+    if (!admissible(key))
+        return nullptr;
+    return insert(createNode(Name, key));
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void CalendarQueue<Key, Value, Allocator>::decreaseKey(handle x, Key k) {
+    if (k > x->key) {
+        handler->e_log(12, "New key is greater than the current key.\n");
+        return;
+    }
+    if (!admissible(k))
+        return;
+    pop(x);
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    push(x);
+    handler->verbose_log(12, "DecreaseKey function called");
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void CalendarQueue<Key, Value, Allocator>::increaseKey(handle x, Key k) {
+    if (k < x->key) {
+        handler->e_log(12, "New key is less than the current key.\n");
+        return;
+    }
+    pop(x);
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    push(x);
+    handler->verbose_log(12, "IncreaseKey function called");
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void CalendarQueue<Key, Value, Allocator>::erase(handle x) {
+    pop(x);
+    index.erase(x);
+    --size;
+    if (static_cast<int>(buckets.size()) > minBuckets && size < static_cast<int>(buckets.size()) / 2)
+        resize(static_cast<int>(buckets.size()) / 2);
+    handler->verbose_log(12, "Erase function called");
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void CalendarQueue<Key, Value, Allocator>::meld(CalendarQueue &&other) {
+    if (&other == this || other.size == 0) return;
+
+    if (size < other.size) {
+        buckets.swap(other.buckets);
+        std::swap(width, other.width);
+        std::swap(day, other.day);
+        std::swap(size, other.size);
+    }
+    for (Node<Value, Key> *x: other.buckets) {
+        while (x != nullptr) {
+            Node<Value, Key> *next = x->right;
+            push(x);
+            ++size;
+            x = next;
+        }
+    }
+    if (size > 2 * static_cast<int>(buckets.size()))
+        resize(1 << bitWidth(static_cast<unsigned long long>(size)));
+
+    index.merge(other.index);
+    allocator.merge(other.allocator);
+    other.buckets.assign(minBuckets, nullptr);
+    other.width = 1;
+    other.day = 0;
+    other.size = 0;
+    handler->verbose_log(12, "Meld function called.");
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+Node<Value, Key> *CalendarQueue<Key, Value, Allocator>::extractMin() {
+    if (size == 0) {
+        handler->e_log(Keyed::notFound);
+        return nullptr;
+    }
+    Node<Value, Key> *minptr = locateMin();
+    erase(minptr);
+    handler->verbose_log(12, "ExtractMin function called.");
+    return minptr;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+std::vector<typename CalendarQueue<Key, Value, Allocator>::handle>
+CalendarQueue<Key, Value, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    if (k <= 0) return result;
+    for (Node<Value, Key> *x: buckets) {
+        for (; x != nullptr; x = x->right)
+            result.push_back(x);
+    }
+    std::size_t take = std::min<std::size_t>(k, result.size());
+    std::partial_sort(result.begin(), result.begin() + take, result.end(),
+                      [](Node<Value, Key> *a, Node<Value, Key> *b) { return a->key < b->key; });
+    result.resize(take);
+    return result;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+Node<Value, Key> *CalendarQueue<Key, Value, Allocator>::displayMinimum() {
+    return size == 0 ? nullptr : locateMin();
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void CalendarQueue<Key, Value, Allocator>::display() {
+    handler->verbose_log(12, "Display Function called.");
+    if (size == 0) {
+        handler->e_log(Keyed::emptyHeap);
+        return;
+    }
+    std::cout << "Day width: " << width << std::endl;
+    for (std::size_t b = 0; b < buckets.size(); b++) {
+        if (buckets[b] == nullptr) continue;
+        std::cout << "Bucket " << b << ":" << std::endl;
+        for (Node<Value, Key> *x = buckets[b]; x != nullptr; x = x->right)
+            std::cout << "  Key: " << x->key << ", Name: " << x->getName() << std::endl;
+    }
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+bool CalendarQueue<Key, Value, Allocator>::isEmpty() {
+    return size == 0;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+int CalendarQueue<Key, Value, Allocator>::getSize() {
+    return size;
+}
+
+#endif // CALENDARQUEUE_H
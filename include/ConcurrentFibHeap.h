@@ -0,0 +1,376 @@
+#ifndef CONCURRENTFIBHEAP_H
+#define CONCURRENTFIBHEAP_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "FibHeap.h"
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "error_handler.h"
+
+/**
+ * @class ConcurrentFibHeap
+ * @brief Thread-safe FibHeap front-end built on flat combining.
+ *
+ * A calling thread publishes its operation in a request slot and then tries to
+ * become the combiner. The combiner applies every published request, its own
+ * and those of the waiting threads, in one pass over the slots. The other
+ * threads spin until their slot is served. Under contention the heap is
+ * therefore touched by one thread at a time in batches, instead of having its
+ * cache lines passed around by a lock convoy.
+ *
+ * Every operation that changes the heap, node allocation included, runs on the
+ * combiner, so the wrapped heap and its allocator are only ever changed by one
+ * thread at a time. find and topK only read, so they skip the slots and read
+ * the heap directly under a shared lock, which the combiner holds exclusively
+ * while it combines. Readers therefore run in parallel with each other.
+ * Handles stay plain node pointers; a handle must not be used once another
+ * thread may have extracted or erased its node.
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Compare Strict weak ordering on keys; the node that compares first is the minimum.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key>,
+    template<typename> class Allocator = NodePool>
+class ConcurrentFibHeap {
+private:
+    using Heap = FibHeap<Key, Value, Compare, Allocator>;
+
+    /**
+     * @brief A published operation. Each slot sits on its own cache line.
+     */
+    struct alignas(64) Request {
+        std::atomic<bool> claimed{false}; ///< Whether a thread owns the slot.
+        std::atomic<bool> pending{false}; ///< Whether the operation waits for the combiner.
+        void (*apply)(Heap &, void *) = nullptr; ///< Runs the operation on the heap.
+        void *context = nullptr; ///< The caller's operation object, alive until pending is cleared.
+    };
+
+    static constexpr int slotCount = 64; ///< Threads that can publish at once; more wait for a free slot.
+    static constexpr int combinePasses = 3; ///< Passes a combiner makes over the slots to pick up late requests.
+
+    Heap heap; ///< The wrapped heap; changed only by the combiner.
+    error_handler *handler;
+    std::array<Request, slotCount> requests;
+    alignas(64) std::atomic<bool> combining{false}; ///< Held by the thread currently combining.
+    mutable std::shared_mutex readers; ///< Shared by find and topK, exclusive to the combiner while it combines.
+
+    /**
+     * @brief Claims a free request slot, starting from one picked by the thread id.
+     */
+    Request &claim();
+
+    /**
+     * @brief Applies every pending request. Called only while holding combining.
+     */
+    void combine();
+
+    /**
+     * @brief Publishes an operation and returns once a combiner has run it.
+     *
+     * @param op Callable taking the wrapped heap; it runs on whichever thread combines.
+     */
+    template<typename Op>
+    void run(Op &&op);
+
+public:
+    /**
+     * @brief Stable reference to a node in the heap.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
+    /**
+     * @brief Constructs a new, empty concurrent heap.
+     */
+    ConcurrentFibHeap(error_handler *handler);
+
+    ConcurrentFibHeap(const ConcurrentFibHeap &) = delete;
+    ConcurrentFibHeap &operator=(const ConcurrentFibHeap &) = delete;
+
+    /**
+     * @brief Allocates a node from the heap's allocator without inserting it.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the heap to the allocator.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the heap.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the heap.
+     *
+     * @param x The node to be inserted.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the heap.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Lowers the key of a node.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the heap without searching for it.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another concurrent heap into this one.
+     *
+     * The other heap's nodes are first moved out under its own combiner and then
+     * melded in under this one, so the two heaps are never held at once.
+     *
+     * @param other The heap to meld into this one. It is left empty.
+     */
+    void meld(ConcurrentFibHeap &&other);
+
+    /**
+     * @brief Extracts the minimum node from the heap.
+     *
+     * @return Node<Value, Key>* The minimum node, or nullptr if the heap is empty.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the heap.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the minimum node in the heap.
+     *
+     * @return Node<Value, Key>* The minimum node at the time of the call.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Modifies the key of a node.
+     */
+    void modifyKey(Key k, Key new_k);
+
+    /**
+     * @brief Deletes a node with a specific key from the heap and frees it.
+     */
+    void deleteNode(Key k);
+
+    /**
+     * @brief Displays the structure of the heap.
+     */
+    void display();
+
+    /**
+     * @brief Finds a node with a specific key in the heap.
+     */
+    Node<Value, Key> *find(Key key) const;
+
+    /**
+     * @brief Checks if the heap is empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the heap.
+     */
+    int getSize();
+};
+
+// Implementation of the ConcurrentFibHeap template class
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+ConcurrentFibHeap<Key, Value, Compare, Allocator>::ConcurrentFibHeap(error_handler *handler) : heap(handler), handler(handler) {}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename ConcurrentFibHeap<Key, Value, Compare, Allocator>::Request &
+ConcurrentFibHeap<Key, Value, Compare, Allocator>::claim() {
+    std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % slotCount;
+    while (true) {
+        for (std::size_t i = 0; i < slotCount; i++) {
+            Request &r = requests[(start + i) % slotCount];
+            if (!r.claimed.load(std::memory_order_relaxed) && !r.claimed.exchange(true, std::memory_order_acquire))
+                return r;
+        }
+        std::this_thread::yield();
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::combine() {
+    std::unique_lock<std::shared_mutex> exclusive(readers);
+    for (int pass = 0; pass < combinePasses; pass++) {
+        bool served = false;
+        for (Request &r: requests) {
+            if (r.pending.load(std::memory_order_acquire)) {
+                r.apply(heap, r.context);
+                r.pending.store(false, std::memory_order_release);
+                served = true;
+            }
+        }
+        if (!served) break;
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+template<typename Op>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::run(Op &&op) {
+    using OpType = std::remove_reference_t<Op>;
+    Request &r = claim();
+    r.apply = [](Heap &h, void *context) { (*static_cast<OpType *>(context))(h); };
+    r.context = const_cast<void *>(static_cast<const void *>(&op));
+    r.pending.store(true, std::memory_order_release);
+
+    while (r.pending.load(std::memory_order_acquire)) {
+        if (!combining.load(std::memory_order_relaxed) && !combining.exchange(true, std::memory_order_acquire)) {
+            combine();
+            combining.store(false, std::memory_order_release);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    r.claimed.store(false, std::memory_order_release);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename ConcurrentFibHeap<Key, Value, Compare, Allocator>::handle
+ConcurrentFibHeap<Key, Value, Compare, Allocator>::createNode(Value Name, Key key) {
+    handle x = nullptr;
+    run([&](Heap &h) { x = h.createNode(Name, key); });
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::destroyNode(handle x) {
+    run([&](Heap &h) { h.destroyNode(x); });
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::clear() {
+    run([](Heap &h) { h.clear(); });
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename ConcurrentFibHeap<Key, Value, Compare, Allocator>::handle
+ConcurrentFibHeap<Key, Value, Compare, Allocator>::insert(Node<Value, Key> *x) {
+    run([&](Heap &h) { h.insert(x); });
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename ConcurrentFibHeap<Key, Value, Compare, Allocator>::handle
+ConcurrentFibHeap<Key, Value, Compare, Allocator>::insert(Value Name, Key key) {
+    handle x = nullptr;
+    run([&](Heap &h) { x = h.insert(Name, key); });
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::decreaseKey(handle x, Key k) {
+    run([&](Heap &h) { h.decreaseKey(x, k); });
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::increaseKey(handle x, Key k) {
+    run([&](Heap &h) { h.increaseKey(x, k); });
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::erase(handle x) {
+    run([&](Heap &h) { h.erase(x); });
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::meld(ConcurrentFibHeap &&other) {
+    if (&other == this) return;
+
+    // Both combiners hand the nodes over through a private heap, so no thread waits on two heaps at once
+    Heap moved(handler);
+    other.run([&](Heap &h) { moved.meld(std::move(h)); });
+    run([&](Heap &h) { h.meld(std::move(moved)); });
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *ConcurrentFibHeap<Key, Value, Compare, Allocator>::extractMin() {
+    handle x = nullptr;
+    run([&](Heap &h) { x = h.extractMin(); });
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+std::vector<typename ConcurrentFibHeap<Key, Value, Compare, Allocator>::handle>
+ConcurrentFibHeap<Key, Value, Compare, Allocator>::topK(int k) const {
+    std::shared_lock<std::shared_mutex> shared(readers);
+    return heap.topK(k);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *ConcurrentFibHeap<Key, Value, Compare, Allocator>::displayMinimum() {
+    handle x = nullptr;
+    run([&](Heap &h) { x = h.displayMinimum(); });
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::modifyKey(Key k, Key new_k) {
+    run([&](Heap &h) { h.modifyKey(k, new_k); });
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::deleteNode(Key k) {
+    run([&](Heap &h) { h.deleteNode(k); });
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void ConcurrentFibHeap<Key, Value, Compare, Allocator>::display() {
+    run([](Heap &h) { h.display(); });
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *ConcurrentFibHeap<Key, Value, Compare, Allocator>::find(Key key) const {
+    std::shared_lock<std::shared_mutex> shared(readers);
+    return heap.find(key);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+bool ConcurrentFibHeap<Key, Value, Compare, Allocator>::isEmpty() {
+    bool empty = true;
+    run([&](Heap &h) { empty = h.isEmpty(); });
+    return empty;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int ConcurrentFibHeap<Key, Value, Compare, Allocator>::getSize() {
+    int size = 0;
+    run([&](Heap &h) { size = h.getSize(); });
+    return size;
+}
+
+#endif // CONCURRENTFIBHEAP_H
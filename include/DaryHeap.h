@@ -0,0 +1,449 @@
+#ifndef DARYHEAP_H
+#define DARYHEAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
+#include "error_handler.h"
+
+/**
+ * @class DaryHeap
+ * @brief Represents an implicit d-ary heap stored in one contiguous array.
+ *
+ * Entries hold a copy of the key next to the node pointer, so sifting compares
+ * keys that sit side by side in memory instead of following node pointers. Each
+ * node records its array position in slot, which lets decrease-key, increase-key
+ * and erase work by handle (or by key through the index) in O(log_d n).
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam D The arity of the heap, e.g. 4 or 8.
+ * @tparam Compare Strict weak ordering on keys; the node that compares first is the minimum.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, int D = 4, typename Compare = std::less<Key>,
+    template<typename> class Allocator = NodePool>
+class DaryHeap : public KeyedHeap<DaryHeap<Key, Value, D, Compare, Allocator>, Key, Value, 7, Compare> {
+private:
+    using Keyed = KeyedHeap<DaryHeap, Key, Value, 7, Compare>;
+    friend Keyed;
+
+    static_assert(D >= 2, "DaryHeap needs an arity of at least 2");
+
+    /**
+     * @brief A key stored next to its node so sifting stays inside the array.
+     */
+    struct Entry {
+        Key key;
+        Node<Value, Key> *node;
+    };
+
+    std::vector<Entry> heap; ///< The implicit tree; the children of i are D * i + 1 ... D * i + D.
+    KeyIndex<Key, Value> index; ///< Key to node index backing find().
+    error_handler *handler;
+    Compare comp; ///< Key ordering; comp(a, b) means a belongs above b.
+    Allocator<Node<Value, Key> > allocator; ///< Storage for every node created through this heap.
+
+    /**
+     * @brief Writes an entry into a position and records that position in its node.
+     */
+    void place(std::size_t i, const Entry &entry);
+
+    /**
+     * @brief Moves the entry at position i up until its parent is not larger.
+     */
+    void siftUp(std::size_t i);
+
+    /**
+     * @brief Moves the entry at position i down until none of its children is smaller.
+     */
+    void siftDown(std::size_t i);
+
+    /**
+     * @brief Restores heap order over the whole array bottom-up in O(n). Slots must already be set.
+     */
+    void heapify();
+
+public:
+    /**
+     * @brief Stable reference to a node in the heap.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
+    /**
+     * @brief Constructs a new, empty d-ary heap.
+     */
+    DaryHeap(error_handler *handler);
+
+    /**
+     * @brief Destroys the heap and releases every node still in it.
+     */
+    ~DaryHeap();
+
+    DaryHeap(const DaryHeap &) = delete;
+    DaryHeap &operator=(const DaryHeap &) = delete;
+
+    /**
+     * @brief Allocates a node from the heap's allocator without inserting it.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the heap to the allocator.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the heap.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the heap.
+     *
+     * @param x The node to be inserted.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the heap.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Inserts a batch of nodes that are in no heap, rebuilding the array bottom-up in linear time.
+     *
+     * The rebuild covers the whole array, so this pays off when the batch is large
+     * next to the heap, e.g. for nodes handed over by another heap's detachAll().
+     *
+     * @param first Iterator to the first node to insert.
+     * @param last Iterator past the last node to insert.
+     */
+    template<typename InputIt>
+    void insertNodes(InputIt first, InputIt last);
+
+    /**
+     * @brief Empties the heap without freeing its nodes.
+     *
+     * @param out Receives every node of the heap, now owned by the caller.
+     */
+    void detachAll(std::vector<handle> &out);
+
+    /**
+     * @brief Lowers the key of a node and sifts it up.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node and sifts it down.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the heap without searching for it.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another heap into this one by appending its array and re-heapifying in O(n + m).
+     *
+     * @param other The heap to meld into this one. It is left empty.
+     */
+    void meld(DaryHeap &&other);
+
+    /**
+     * @brief Extracts the minimum node from the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the heap, in O(k log k).
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the minimum node in the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Displays the heap array level by level.
+     */
+    void display();
+
+    /**
+     * @brief Checks if the heap is empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the heap.
+     */
+    int getSize();
+};
+
+// Implementation of the DaryHeap template class
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+DaryHeap<Key, Value, D, Compare, Allocator>::DaryHeap(error_handler *handler) : handler(handler) {}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+DaryHeap<Key, Value, D, Compare, Allocator>::~DaryHeap() {
+    clear();
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+typename DaryHeap<Key, Value, D, Compare, Allocator>::handle
+DaryHeap<Key, Value, D, Compare, Allocator>::createNode(Value Name, Key key) {
+    return allocator.allocate(Name, key);
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::destroyNode(handle x) {
+    allocator.deallocate(x);
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::clear() {
+    if constexpr (Allocator<Node<Value, Key> >::bulk_release && std::is_trivially_destructible<Node<Value, Key> >::value) {
+        allocator.release();
+    } else {
+        for (const Entry &entry: heap)
+            allocator.deallocate(entry.node);
+    }
+    heap.clear();
+    index.clear();
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::place(std::size_t i, const Entry &entry) {
+    heap[i] = entry;
+    entry.node->slot = static_cast<int>(i);
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::siftUp(std::size_t i) {
+    Entry moving = heap[i];
+    while (i > 0) {
+        std::size_t parent = (i - 1) / D;
+        if (!comp(moving.key, heap[parent].key))
+            break;
+        place(i, heap[parent]);
+        i = parent;
+    }
+    place(i, moving);
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::siftDown(std::size_t i) {
+    Entry moving = heap[i];
+    std::size_t n = heap.size();
+    while (true) {
+        std::size_t first = D * i + 1;
+        if (first >= n)
+            break;
+        std::size_t last = std::min(first + D, n);
+        std::size_t best = first;
+        for (std::size_t c = first + 1; c < last; c++) {
+            if (comp(heap[c].key, heap[best].key))
+                best = c;
+        }
+        if (!comp(heap[best].key, moving.key))
+            break;
+        place(i, heap[best]);
+        i = best;
+    }
+    place(i, moving);
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::heapify() {
+    if (heap.size() > 1) {
+        for (std::size_t i = (heap.size() - 2) / D + 1; i-- > 0;)
+            siftDown(i);
+    }
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+typename DaryHeap<Key, Value, D, Compare, Allocator>::handle
+DaryHeap<Key, Value, D, Compare, Allocator>::insert(Node<Value, Key> *x) {
+    heap.push_back({x->key, x});
+    siftUp(heap.size() - 1);
+    index.insert(x);
+    handler->verbose_log(7, "Insert function called.");
+    return x;
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+typename DaryHeap<Key, Value, D, Compare, Allocator>::handle
+DaryHeap<Key, Value, D, Compare, Allocator>::insert(Value Name, Key key) {
+    return insert(createNode(Name, key));
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+template<typename InputIt>
+void DaryHeap<Key, Value, D, Compare, Allocator>::insertNodes(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+        Node<Value, Key> *x = *first;
+        x->slot = static_cast<int>(heap.size());
+        heap.push_back({x->key, x});
+        index.insert(x);
+    }
+    heapify();
+    handler->verbose_log(7, "InsertNodes function called.");
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::detachAll(std::vector<handle> &out) {
+    for (const Entry &entry: heap)
+        out.push_back(entry.node);
+    heap.clear();
+    index.clear();
+    handler->verbose_log(7, "DetachAll function called.");
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::decreaseKey(handle x, Key k) {
+    if (comp(x->key, k)) {
+        handler->e_log(7, "New key is greater than the current key.\n");
+        return;
+    }
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    heap[x->slot].key = k;
+    siftUp(x->slot);
+    handler->verbose_log(7, "DecreaseKey function called");
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::increaseKey(handle x, Key k) {
+    if (comp(k, x->key)) {
+        handler->e_log(7, "New key is less than the current key.\n");
+        return;
+    }
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    heap[x->slot].key = k;
+    siftDown(x->slot);
+    handler->verbose_log(7, "IncreaseKey function called");
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::erase(handle x) {
+    std::size_t i = x->slot;
+    Entry moved = heap.back();
+    heap.pop_back();
+    if (i < heap.size()) {
+        place(i, moved);
+        if (i > 0 && comp(moved.key, heap[(i - 1) / D].key))
+            siftUp(i);
+        else
+            siftDown(i);
+    }
+    index.erase(x);
+    handler->verbose_log(7, "Erase function called");
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::meld(DaryHeap &&other) {
+    if (&other == this) return;
+
+    heap.insert(heap.end(), other.heap.begin(), other.heap.end());
+    for (std::size_t i = 0; i < heap.size(); i++)
+        heap[i].node->slot = static_cast<int>(i);
+    heapify();
+    index.merge(other.index);
+    allocator.merge(other.allocator);
+    other.heap.clear();
+    handler->verbose_log(7, "Meld function called.");
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *DaryHeap<Key, Value, D, Compare, Allocator>::extractMin() {
+    if (heap.empty()) {
+        handler->e_log(Keyed::notFound);
+        return nullptr;
+    }
+    Node<Value, Key> *minptr = heap.front().node;
+    erase(minptr);
+    handler->verbose_log(7, "ExtractMin function called.");
+    return minptr;
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+std::vector<typename DaryHeap<Key, Value, D, Compare, Allocator>::handle>
+DaryHeap<Key, Value, D, Compare, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    if (heap.empty() || k <= 0) return result;
+    auto later = [this](std::size_t a, std::size_t b) { return comp(heap[b].key, heap[a].key); };
+
+    std::vector<std::size_t> candidates(1, 0);
+    result.reserve(std::min<std::size_t>(k, heap.size()));
+    while (static_cast<int>(result.size()) < k && !candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), later);
+        std::size_t i = candidates.back();
+        candidates.pop_back();
+        result.push_back(heap[i].node);
+
+        std::size_t first = D * i + 1;
+        std::size_t last = std::min(first + D, heap.size());
+        for (std::size_t c = first; c < last; c++) {
+            candidates.push_back(c);
+            std::push_heap(candidates.begin(), candidates.end(), later);
+        }
+    }
+    return result;
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *DaryHeap<Key, Value, D, Compare, Allocator>::displayMinimum() {
+    return heap.empty() ? nullptr : heap.front().node;
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+void DaryHeap<Key, Value, D, Compare, Allocator>::display() {
+    handler->verbose_log(7, "Display Function called.");
+    if (heap.empty()) {
+        handler->e_log(Keyed::emptyHeap);
+        return;
+    }
+    std::size_t levelStart = 0, levelSize = 1;
+    for (int level = 0; levelStart < heap.size(); level++) {
+        std::cout << "Level " << level << ":";
+        for (std::size_t i = levelStart; i < std::min(levelStart + levelSize, heap.size()); i++)
+            std::cout << " " << heap[i].key;
+        std::cout << std::endl;
+        levelStart += levelSize;
+        levelSize *= D;
+    }
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+bool DaryHeap<Key, Value, D, Compare, Allocator>::isEmpty() {
+    return heap.empty();
+}
+
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+int DaryHeap<Key, Value, D, Compare, Allocator>::getSize() {
+    return static_cast<int>(heap.size());
+}
+
+#endif // DARYHEAP_H
@@ -4,7 +4,7 @@
 /**
  * Forward declaration of FibHeap class template.
  */
-template<typename T>
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
 class FibHeap;
 
 /**
@@ -24,11 +24,12 @@ class VisualizeTaskManager;
  * It supports insertion, deletion, and display of nodes.
  *
  * @tparam T The type of data stored in the nodes.
+ * @tparam K The type of the nodes' keys.
  */
-template<typename T>
+template<typename T, typename K = int>
 class DoublyCircularLinkedList {
 private:
-    Node<T> *head; ///< Pointer to the head node of the list.
+    Node<T, K> *head; ///< Pointer to the head node of the list.
     int size; ///< Number of nodes in the list.
 
     /**
@@ -36,7 +37,14 @@ private:
      *
      * @param newNode Pointer to the new node to be inserted.
      */
-    void insert(Node<T> *newNode); // Private insert function
+    void insert(Node<T, K> *newNode); // Private insert function
+
+    /**
+     * @brief Moves every node of another list to the end of this one in O(1).
+     *
+     * @param other The list to empty into this one.
+     */
+    void splice(DoublyCircularLinkedList &other);
 
 public:
     /**
@@ -62,7 +70,7 @@ public:
      *
      * @param curr Pointer to the node to be deleted.
      */
-    void deleteNode(Node<T> *curr);
+    void deleteNode(Node<T, K> *curr);
 
     /**
      * @brief Displays the contents of the list.
@@ -82,24 +90,25 @@ public:
      * @param x Pointer to the node to be removed.
      * @return Pointer to the removed node.
      */
-    Node<T> *remove(Node<T> *x);
+    Node<T, K> *remove(Node<T, K> *x);
 
     // Friend classes to allow access to private members
-    friend class FibHeap<T>;
+    template<typename, typename, typename, template<typename> class>
+    friend class FibHeap;
     friend class VisualizeFibonacciHeap;
     friend class VisualizeTaskManager;
 };
 
-template<typename T>
-DoublyCircularLinkedList<T>::DoublyCircularLinkedList() : head(nullptr), size(0) {
+template<typename T, typename K>
+DoublyCircularLinkedList<T, K>::DoublyCircularLinkedList() : head(nullptr), size(0) {
 }
 
-template<typename T>
-DoublyCircularLinkedList<T>::~DoublyCircularLinkedList() {
+template<typename T, typename K>
+DoublyCircularLinkedList<T, K>::~DoublyCircularLinkedList() {
     if (head) {
-        Node<T> *current = head;
+        Node<T, K> *current = head;
         do {
-            Node<T> *next = current->right;
+            Node<T, K> *next = current->right;
             delete current;
             current = next;
         } while (current != head);
@@ -107,14 +116,14 @@ DoublyCircularLinkedList<T>::~DoublyCircularLinkedList() {
     }
 }
 
-template<typename T>
-void DoublyCircularLinkedList<T>::insert(Node<T> *newNode) {
+template<typename T, typename K>
+void DoublyCircularLinkedList<T, K>::insert(Node<T, K> *newNode) {
     if (!head) {
         head = newNode;
         newNode->right = newNode;
         newNode->left = newNode;
     } else {
-        Node<T> *tail = head->left;
+        Node<T, K> *tail = head->left;
         newNode->right = head;
         newNode->left = tail;
         tail->right = newNode;
@@ -123,21 +132,40 @@ void DoublyCircularLinkedList<T>::insert(Node<T> *newNode) {
     size++;
 }
 
+template<typename T, typename K>
+void DoublyCircularLinkedList<T, K>::splice(DoublyCircularLinkedList &other) {
+    if (!other.head) return;
+
+    if (!head) {
+        head = other.head;
+    } else {
+        Node<T, K> *tail = head->left;
+        Node<T, K> *otherTail = other.head->left;
+        tail->right = other.head;
+        other.head->left = tail;
+        otherTail->right = head;
+        head->left = otherTail;
+    }
+    size += other.size;
+    other.head = nullptr;
+    other.size = 0;
+}
+
 // template<typename T>
 // void DoublyCircularLinkedList<T>::insert(T Name, int key) {
 //     auto *newNode = new Node<T>(Name, key);
 //     insert(newNode); // Call the private insert function
 // }
 
-template<typename T>
-void DoublyCircularLinkedList<T>::deleteNode(Node<T> *curr) {
+template<typename T, typename K>
+void DoublyCircularLinkedList<T, K>::deleteNode(Node<T, K> *curr) {
     if (!head || !curr) return;
 
     if (curr->right == curr) {
         head = nullptr;
     } else {
-        Node<T> *prev = curr->left;
-        Node<T> *next = curr->right;
+        Node<T, K> *prev = curr->left;
+        Node<T, K> *next = curr->right;
         prev->right = next;
         next->left = prev;
         if (curr == head) {
@@ -148,31 +176,31 @@ void DoublyCircularLinkedList<T>::deleteNode(Node<T> *curr) {
     size--;
 }
 
-template<typename T>
-void DoublyCircularLinkedList<T>::display() const {
+template<typename T, typename K>
+void DoublyCircularLinkedList<T, K>::display() const {
     if (!head) return;
 
-    Node<T> *current = head;
+    Node<T, K> *current = head;
     do {
         std::cout << "Name: " << current->getName() << ", Key: " << current->getKey() << std::endl;
         current = current->right;
     } while (current != head);
 }
 
-template<typename T>
-int DoublyCircularLinkedList<T>::getSize() const {
+template<typename T, typename K>
+int DoublyCircularLinkedList<T, K>::getSize() const {
     return size;
 }
 
-template<typename T>
-Node<T> *DoublyCircularLinkedList<T>::remove(Node<T> *x) {
+template<typename T, typename K>
+Node<T, K> *DoublyCircularLinkedList<T, K>::remove(Node<T, K> *x) {
     if (!head || !x) return nullptr;
 
     if (x->right == x) {
         head = nullptr;
     } else {
-        Node<T> *prev = x->left;
-        Node<T> *next = x->right;
+        Node<T, K> *prev = x->left;
+        Node<T, K> *next = x->right;
         prev->right = next;
         next->left = prev;
         if (x == head) {
@@ -1,13 +1,26 @@
 #ifndef FIBHEAP_H
 #define FIBHEAP_H
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "DoublyCircularLinkedList.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
 #include "error_handler.h"
 
 // Forward declarations
-template<typename T>
+template<typename T, typename K>
 class Node;
 
 class VisualizeFibonacciHeap;
@@ -22,15 +35,56 @@ class VisualizeTaskManager;
  * operations such as insertion, merging, extracting the minimum, and
  * decreasing or increasing keys.
  *
- * @tparam T The type of data stored in the heap nodes.
+ * The ordering is fixed at compile time by Compare, so each specialization
+ * inlines its own comparisons. "Minimum" and "decrease" always refer to that
+ * ordering; FibHeap<Key, Value, std::greater<Key> > is a max-heap.
+ *
+ * With lazy delete switched on, deleteNode() only tombstones the node. Dead
+ * nodes keep their place in the forest and are dropped when they surface in
+ * the root list during the next consolidation.
+ *
+ * Other threads may add nodes with post() while one owning thread runs every
+ * other operation. Posted nodes are pushed onto lock-free stacks and joined to
+ * the root list the next time the owner extracts, changes a key or asks for the
+ * size, so producers never wait for the consumer. post() needs a thread-safe
+ * allocator, so the default FibHeap<Key, Value> on NodePool cannot call it; use
+ * FibHeap<Key, Value, Compare, NodeNewDelete> instead.
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Compare Strict weak ordering on keys; the node that compares first is the minimum.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
  */
-template<typename T>
+template<typename Key, typename Value, typename Compare = std::less<Key>,
+    template<typename> class Allocator = NodePool>
 class FibHeap {
 private:
-    Node<T> *min; ///< Pointer to the node with the minimum key.
+    Node<Value, Key> *min; ///< Pointer to the node with the minimum key.
     int size; ///< Number of nodes in the heap.
-    DoublyCircularLinkedList<T> rootList; ///< Root linked list.
+    DoublyCircularLinkedList<Value, Key> rootList; ///< Root linked list.
+    /// Key to node index backing find(). Only insert, extractMin and modifyKey change which keys are live;
+    /// link() and cut() move nodes between lists without touching keys, so the entries stay valid across them.
+    KeyIndex<Key, Value> index;
     error_handler * handler;
+    Compare comp; ///< Key ordering; comp(a, b) means a belongs above b.
+    std::vector<Node<Value, Key> *> degreeTable; ///< Scratch degree table reused by every consolidate().
+    std::vector<Node<Value, Key> *> frontier; ///< Scratch binary heap of candidate roots reused by extractK().
+    Allocator<Node<Value, Key> > allocator; ///< Storage for every node created through this heap.
+    bool lazyDelete = false; ///< Whether deleteNode() tombstones nodes instead of removing them.
+    int tombstones = 0; ///< Dead nodes still linked into the forest; not counted in size.
+    std::vector<Node<Value, Key> *> dead; ///< Scratch stack of dead roots reused by dropDeadRoots().
+
+    /**
+     * @brief A lock-free stack of posted nodes linked through right, on its own cache line.
+     */
+    struct alignas(64) PendingStack {
+        std::atomic<Node<Value, Key> *> head{nullptr};
+    };
+
+    static constexpr int pendingStripes = 8; ///< Stacks that post() spreads producer threads over.
+    static constexpr std::ptrdiff_t minParallelSlice = 1 << 14; ///< Fewest pairs worth giving a worker in insertRangeParallel().
+    std::array<PendingStack, pendingStripes> pending; ///< Nodes posted by other threads and not yet collected.
+    std::atomic<bool> posted{false}; ///< Set by post(), cleared when the owner collects.
 
     /**
      * @brief Links two nodes in the heap.
@@ -38,7 +92,7 @@ private:
      * @param y The node to be linked.
      * @param x The node to which y will be linked.
      */
-    void link(Node<T> *y, Node<T> *x);
+    void link(Node<Value, Key> *y, Node<Value, Key> *x);
 
     /**
      * @brief Consolidates the heap to maintain the Fibonacci heap properties.
@@ -51,53 +105,279 @@ private:
      * @param x The node to be cut.
      * @param y The parent node.
      */
-    void cut(Node<T> *x, Node<T> *y);
+    void cut(Node<Value, Key> *x, Node<Value, Key> *y);
 
     /**
      * @brief Performs a cascading cut operation.
      *
      * @param y The node to perform the cascading cut on.
      */
-    void cascadingCut(Node<T> *y);
+    void cascadingCut(Node<Value, Key> *y);
 
     /**
-     * @brief Searches for a node with a specific key starting from the given node.
+     * @brief Frees every dead node in the root list, promoting its children until only live roots remain.
+     */
+    void dropDeadRoots();
+
+    /**
+     * @brief Joins a chain of new roots to the root list with one splice and updates the minimum.
      *
-     * @param root The starting node for the search.
-     * @param key The key to search for.
-     * @return Node<T>* The node with the specified key, or nullptr if not found.
+     * @param batch The new roots, already in the key index. It is left empty.
      */
-    Node<T> *search(Node<T> *root, int key) const;
+    void spliceBatch(DoublyCircularLinkedList<Value, Key> &batch);
 
 public:
     friend class VisualizeFibonacciHeap;
     friend class VisualizeTaskManager;
 
+    /**
+     * @brief Stable reference to a node in the heap.
+     *
+     * A handle stays valid until its node is extracted or erased, so callers can
+     * keep it and modify the node later without searching for it.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
     /**
      * @brief Constructs a new Fibonacci Heap object.
      */
     FibHeap(error_handler * handler);
 
+    /**
+     * @brief Constructs a heap holding a batch of (name, key) pairs.
+     *
+     * @param handler The error handler used for logging.
+     * @param items The names and keys to insert, see insertRange().
+     */
+    FibHeap(error_handler * handler, const std::vector<std::pair<Value, Key> > &items);
+
+    /**
+     * @brief Destroys the heap and releases every node still in it.
+     */
+    ~FibHeap();
+
+    FibHeap(const FibHeap &) = delete;
+    FibHeap &operator=(const FibHeap &) = delete;
+
+    /**
+     * @brief Allocates a node from the heap's allocator without inserting it.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The new node.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the heap to the allocator.
+     *
+     * Nodes handed back by extractMin or erase must be released here rather than
+     * with delete, since they live in the allocator's storage.
+     *
+     * @param x The node to release. Null is ignored.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the heap.
+     *
+     * With an allocator that supports bulk release (NodeArena) and trivially
+     * destructible nodes this drops all storage at once without visiting nodes.
+     */
+    void clear();
+
     /**
      * @brief Inserts a node into the heap.
      *
      * @param x The node to be inserted.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the heap.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Inserts a batch of (name, key) pairs.
+     *
+     * The new nodes are chained together first and joined to the root list with a
+     * single splice. The batch minimum is found in one pass at the end instead of
+     * one comparison, counter update and log line per node.
+     *
+     * @param first Iterator to the first std::pair<Value, Key> to insert.
+     * @param last Iterator past the last pair to insert.
+     */
+    template<typename InputIt>
+    void insertRange(InputIt first, InputIt last);
+
+    /**
+     * @brief Inserts a batch of nodes that are in no heap, in O(1) per node.
+     *
+     * The nodes' links are reset and they join the root list with a single splice,
+     * as in insertRange(). Meant for nodes handed over by another heap's detachAll().
+     *
+     * @param first Iterator to the first node to insert.
+     * @param last Iterator past the last node to insert.
      */
-    void insert(Node<T> *x);
+    template<typename InputIt>
+    void insertNodes(InputIt first, InputIt last);
+
+    /**
+     * @brief Empties the heap without freeing its nodes, walking the forest once.
+     *
+     * Live nodes are appended to out and owned by the caller; their links are left
+     * as they were. Lazily deleted nodes still in the forest are freed instead.
+     *
+     * @param out Receives every live node of the heap.
+     */
+    void detachAll(std::vector<handle> &out);
+
+    /**
+     * @brief Inserts a large batch of (name, key) pairs using several threads.
+     *
+     * The input is cut into one slice per thread. Each worker builds its own heap
+     * from its slice with insertRange() and, if asked, runs that heap's first
+     * consolidation, so the first consolidation is spread over the workers too.
+     * The worker heaps are then melded pairwise in a reduction tree, one thread
+     * per meld, and the result is melded into this heap. Small batches are
+     * inserted directly.
+     *
+     * @param first Iterator to the first std::pair<Value, Key> to insert.
+     * @param last Iterator past the last pair to insert.
+     * @param threads Number of workers, or 0 to use the hardware concurrency.
+     * @param consolidateSlices Whether each worker consolidates its slice before the melds.
+     */
+    template<typename RandomIt>
+    void insertRangeParallel(RandomIt first, RandomIt last, int threads = 0, bool consolidateSlices = true);
+
+    /**
+     * @brief Adds a node from any thread without blocking.
+     *
+     * The node is pushed onto one of a few lock-free stacks, picked by thread, and
+     * joins the heap at the owner's next collectPending(). Until then find() and
+     * topK() do not see it.
+     *
+     * Once collected the node is owned by this heap, which frees it through its
+     * own allocator, so the node must come from this heap's createNode(). Only
+     * available with a thread-safe allocator such as NodeNewDelete, because
+     * producers then allocate while the owner frees. The default NodePool is not
+     * thread-safe, so FibHeap<Key, Value> and HospitalTaskManager's default engine
+     * cannot call post(); they fail to compile rather than race.
+     *
+     * @param x The node to add, created by this heap's createNode().
+     * @return handle The handle of the node.
+     */
+    handle post(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node and adds it from any thread without blocking.
+     *
+     * Only available with a thread-safe allocator such as NodeNewDelete, so not
+     * with the default NodePool.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The handle of the new node.
+     */
+    handle post(Value Name, Key key);
+
+    /**
+     * @brief Joins every posted node to the root list. Called by the owning thread.
+     *
+     * extractMin, extractK, key changes, erase, meld, clear, size queries and
+     * display call it themselves, so only callers of find() or topK() need to.
+     */
+    void collectPending();
+
+    /**
+     * @brief Lowers the key of a node without searching for it.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be greater than the current one.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node without searching for it.
+     *
+     * The node is cut from its parent and its children are promoted to the root
+     * list, so it ends up as a childless root with the new key. This takes
+     * O(degree) and never consolidates. If the node was the minimum, dead roots are
+     * dropped and the roots are scanned once for the new one.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be less than the current one.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the heap without searching for it.
+     *
+     * The node is not freed; ownership goes back to the caller.
+     *
+     * @param x The handle of the node to be removed.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another heap into this one.
+     *
+     * The two root lists are spliced and the minima compared in O(1). The key
+     * indexes are merged by moving the smaller one into the larger, and the other
+     * heap's node storage is handed to this heap's allocator, so handles from
+     * either heap stay valid. The other heap is left empty.
+     *
+     * @param other The heap to meld into this one.
+     */
+    void meld(FibHeap &&other);
 
     /**
      * @brief Extracts the minimum node from the heap.
      *
-     * @return Node<T>* The minimum node.
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Extracts the k minimum nodes with a single consolidation.
+     *
+     * The current roots are put in a small binary heap. Each extracted node's
+     * children are promoted to the root list and pushed onto it, so the next
+     * minimum is always on top. The root list is consolidated once at the end
+     * instead of once per extracted node.
+     *
+     * @param k The number of nodes to extract. Nothing is done for k <= 0.
+     * @param out Receives the extracted nodes in increasing key order.
+     * @return int The number of nodes extracted, less than k if the heap ran out.
      */
-    Node<T> *extractMin();
+    int extractK(int k, std::vector<handle> &out);
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the heap.
+     *
+     * Walks the heap-ordered forest with a small frontier heap that starts with
+     * the roots and gains a node's children when the node is listed, taking
+     * O(R + k log(R + k)) for R roots.
+     *
+     * @param k The number of nodes to list.
+     * @return std::vector<handle> Up to k nodes in increasing key order.
+     */
+    std::vector<handle> topK(int k) const;
 
     /**
      * @brief Displays the minimum node in the heap.
      *
-     * @return Node<T>* The minimum node.
+     * @return Node<Value, Key>* The minimum node.
      */
-    Node<T> *displayMinimum();
+    Node<Value, Key> *displayMinimum();
 
     /**
      * @brief Modifies the key of a node.
@@ -105,14 +385,36 @@ public:
      * @param k The current key of the node.
      * @param new_k The new key to be assigned.
      */
-    void modifyKey(int k, int new_k);
+    void modifyKey(Key k, Key new_k);
 
     /**
-     * @brief Deletes a node with a specific key from the heap.
+     * @brief Deletes a node with a specific key from the heap and frees it.
      *
      * @param k The key of the node to be deleted.
      */
-    void deleteNode(int k);
+    void deleteNode(Key k);
+
+    /**
+     * @brief Switches lazy delete on or off.
+     *
+     * When on, deleteNode() tombstones the node in O(1) instead of cutting it out
+     * and consolidating. Nodes already tombstoned stay so when it is switched off.
+     *
+     * @param on Whether deleteNode() should tombstone nodes.
+     */
+    void setLazyDelete(bool on);
+
+    /**
+     * @brief Deletes a node through its handle by tombstoning it, and frees it later.
+     *
+     * The node leaves the index and the size at once but stays linked into the
+     * forest until consolidation finds it in the root list. The minimum is always
+     * kept live, so discarding it removes it eagerly. The handle must not be used
+     * again.
+     *
+     * @param x The handle of the node to be deleted.
+     */
+    void discard(handle x);
 
     /**
      * @brief Displays the structure of the heap.
@@ -123,9 +425,9 @@ public:
      * @brief Finds a node with a specific key in the heap.
      *
      * @param key The key to search for.
-     * @return Node<T>* The node with the specified key, or nullptr if not found.
+     * @return Node<Value, Key>* The node with the specified key, or nullptr if not found.
      */
-    Node<T> *find(int key) const;
+    Node<Value, Key> *find(Key key) const;
 
     /**
      * @brief Checks if the heap is empty.
@@ -145,49 +447,313 @@ public:
 
 // Implementation of the FibHeap template class
 
-template<typename T>
-FibHeap<T>::FibHeap(error_handler * handler) : handler(handler), min(nullptr), size(0) {}
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+FibHeap<Key, Value, Compare, Allocator>::FibHeap(error_handler * handler) : handler(handler), min(nullptr), size(0) {}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+FibHeap<Key, Value, Compare, Allocator>::FibHeap(error_handler * handler,
+                                                 const std::vector<std::pair<Value, Key> > &items)
+    : FibHeap(handler) {
+    insertRange(items.begin(), items.end());
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+FibHeap<Key, Value, Compare, Allocator>::~FibHeap() {
+    clear();
+}
 
-template<typename T>
-void FibHeap<T>::insert(Node<T> *x) {
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename FibHeap<Key, Value, Compare, Allocator>::handle FibHeap<Key, Value, Compare, Allocator>::createNode(Value Name, Key key) {
+    return allocator.allocate(Name, key);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::destroyNode(handle x) {
+    allocator.deallocate(x);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::clear() {
+    collectPending();
+    if constexpr (Allocator<Node<Value, Key> >::bulk_release && std::is_trivially_destructible<Node<Value, Key> >::value) {
+        allocator.release();
+    } else if (rootList.head != nullptr) {
+        std::vector<Node<Value, Key> *> pending;
+        Node<Value, Key> *root = rootList.head;
+        do {
+            pending.push_back(root);
+            root = root->right;
+        } while (root != rootList.head);
+        while (!pending.empty()) {
+            Node<Value, Key> *x = pending.back();
+            pending.pop_back();
+            Node<Value, Key> *child = x->child;
+            for (int i = 0; i < x->deg; i++) {
+                pending.push_back(child);
+                child = child->right;
+            }
+            allocator.deallocate(x);
+        }
+    }
+    rootList = DoublyCircularLinkedList<Value, Key>();
+    index.clear();
+    min = nullptr;
+    size = 0;
+    tombstones = 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename FibHeap<Key, Value, Compare, Allocator>::handle FibHeap<Key, Value, Compare, Allocator>::insert(Node<Value, Key> *x) {
     x->deg = 0;
     x->parent = nullptr;
     x->child = nullptr;
     x->mark = false;
+    x->deleted = false;
     rootList.insert(x);
-    if (min == nullptr || x->key < min->key)
+    index.insert(x);
+    if (min == nullptr || comp(x->key, min->key))
         min = x;
     ++size;
 
-    handler->verbose_log(1, "Insert function called: " + x->getName() + "." );
+    handler->verbose_log(1, "Insert function called.");
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename FibHeap<Key, Value, Compare, Allocator>::handle FibHeap<Key, Value, Compare, Allocator>::insert(Value Name, Key key) {
+    return insert(createNode(Name, key));
 }
 
-template<typename T>
-Node<T> *FibHeap<T>::extractMin() {
-    Node<T> *minptr = min;
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+template<typename InputIt>
+void FibHeap<Key, Value, Compare, Allocator>::insertRange(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value)
+        index.reserve(index.size() + std::distance(first, last));
+
+    DoublyCircularLinkedList<Value, Key> batch;
+    for (; first != last; ++first) {
+        Node<Value, Key> *x = createNode(first->first, first->second);
+        batch.insert(x);
+        index.insert(x);
+    }
+    spliceBatch(batch);
+    handler->verbose_log(1, "InsertRange function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+template<typename InputIt>
+void FibHeap<Key, Value, Compare, Allocator>::insertNodes(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value)
+        index.reserve(index.size() + std::distance(first, last));
+
+    DoublyCircularLinkedList<Value, Key> batch;
+    for (; first != last; ++first) {
+        Node<Value, Key> *x = *first;
+        x->deg = 0;
+        x->parent = nullptr;
+        x->child = nullptr;
+        x->mark = false;
+        x->deleted = false;
+        batch.insert(x);
+        index.insert(x);
+    }
+    spliceBatch(batch);
+    handler->verbose_log(1, "InsertNodes function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::spliceBatch(DoublyCircularLinkedList<Value, Key> &batch) {
+    if (batch.head == nullptr) return;
+
+    Node<Value, Key> *batchMin = batch.head;
+    for (Node<Value, Key> *x = batch.head->right; x != batch.head; x = x->right) {
+        if (comp(x->key, batchMin->key))
+            batchMin = x;
+    }
+    size += batch.size;
+    rootList.splice(batch);
+    if (min == nullptr || comp(batchMin->key, min->key))
+        min = batchMin;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::detachAll(std::vector<handle> &out) {
+    collectPending();
+    std::size_t first = out.size();
+    if (rootList.head != nullptr) {
+        Node<Value, Key> *root = rootList.head;
+        do {
+            out.push_back(root);
+            root = root->right;
+        } while (root != rootList.head);
+        // Breadth-first over the forest, using out itself as the queue
+        for (std::size_t i = first; i < out.size(); i++) {
+            Node<Value, Key> *x = out[i];
+            Node<Value, Key> *child = x->child;
+            for (int d = 0; d < x->deg; d++) {
+                out.push_back(child);
+                child = child->right;
+            }
+        }
+    }
+    std::size_t kept = first;
+    for (std::size_t i = first; i < out.size(); i++) {
+        if (out[i]->deleted)
+            allocator.deallocate(out[i]);
+        else
+            out[kept++] = out[i];
+    }
+    out.resize(kept);
+
+    rootList = DoublyCircularLinkedList<Value, Key>();
+    index.clear();
+    min = nullptr;
+    size = 0;
+    tombstones = 0;
+    handler->verbose_log(1, "DetachAll function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+template<typename RandomIt>
+void FibHeap<Key, Value, Compare, Allocator>::insertRangeParallel(RandomIt first, RandomIt last, int threads,
+                                                                  bool consolidateSlices) {
+    std::ptrdiff_t n = last - first;
+    if (threads <= 0)
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threads = static_cast<int>(std::min<std::ptrdiff_t>(threads, n / minParallelSlice));
+    if (threads <= 1) {
+        insertRange(first, last);
+        return;
+    }
+
+    // The worker heaps log to a silent handler so no worker touches the shared one
+    error_handler quiet(false);
+    std::vector<std::unique_ptr<FibHeap> > parts;
+    for (int t = 0; t < threads; t++)
+        parts.push_back(std::make_unique<FibHeap>(&quiet));
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        RandomIt from = first + n * t / threads;
+        RandomIt to = first + n * (t + 1) / threads;
+        workers.emplace_back([&parts, t, from, to, consolidateSlices] {
+            FibHeap &part = *parts[t];
+            part.insertRange(from, to);
+            if (consolidateSlices && part.rootList.head != nullptr)
+                part.consolidate();
+        });
+    }
+    for (std::thread &w: workers)
+        w.join();
+
+    // Reduction tree: in each round part i takes in part i + stride, all pairs at once
+    for (int stride = 1; stride < threads; stride *= 2) {
+        workers.clear();
+        for (int i = 0; i + stride < threads; i += 2 * stride)
+            workers.emplace_back([&parts, i, stride] { parts[i]->meld(std::move(*parts[i + stride])); });
+        for (std::thread &w: workers)
+            w.join();
+    }
+    meld(std::move(*parts[0]));
+    handler->verbose_log(1, "InsertRangeParallel function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename FibHeap<Key, Value, Compare, Allocator>::handle FibHeap<Key, Value, Compare, Allocator>::post(Node<Value, Key> *x) {
+    static_assert(Allocator<Node<Value, Key> >::thread_safe, "post() hands nodes across threads and needs a thread-safe allocator");
+    thread_local const std::size_t stripe = std::hash<std::thread::id>()(std::this_thread::get_id()) % pendingStripes;
+    std::atomic<Node<Value, Key> *> &head = pending[stripe].head;
+    Node<Value, Key> *top = head.load(std::memory_order_relaxed);
+    do {
+        x->right = top;
+    } while (!head.compare_exchange_weak(top, x, std::memory_order_release, std::memory_order_relaxed));
+    posted.store(true, std::memory_order_release);
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename FibHeap<Key, Value, Compare, Allocator>::handle FibHeap<Key, Value, Compare, Allocator>::post(Value Name, Key key) {
+    return post(allocator.allocate(Name, key));
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::collectPending() {
+    if (!posted.load(std::memory_order_relaxed) || !posted.exchange(false, std::memory_order_acquire))
+        return;
+
+    // Same batch splice as insertRange(): chain the posted nodes, then join them in one go
+    DoublyCircularLinkedList<Value, Key> batch;
+    Node<Value, Key> *batchMin = nullptr;
+    for (PendingStack &stack: pending) {
+        Node<Value, Key> *x = stack.head.exchange(nullptr, std::memory_order_acquire);
+        while (x != nullptr) {
+            Node<Value, Key> *next = x->right;
+            x->deg = 0;
+            x->parent = nullptr;
+            x->child = nullptr;
+            x->mark = false;
+            x->deleted = false;
+            batch.insert(x);
+            index.insert(x);
+            if (batchMin == nullptr || comp(x->key, batchMin->key))
+                batchMin = x;
+            x = next;
+        }
+    }
+    if (batch.head == nullptr) return;
+
+    size += batch.size;
+    rootList.splice(batch);
+    if (min == nullptr || comp(batchMin->key, min->key))
+        min = batchMin;
+    handler->verbose_log(1, "CollectPending function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::meld(FibHeap &&other) {
+    if (&other == this) return;
+
+    collectPending();
+    other.collectPending();
+
+    rootList.splice(other.rootList);
+    if (min == nullptr || (other.min != nullptr && comp(other.min->key, min->key)))
+        min = other.min;
+    size += other.size;
+    tombstones += other.tombstones;
+    index.merge(other.index);
+    allocator.merge(other.allocator);
+    other.min = nullptr;
+    other.size = 0;
+    other.tombstones = 0;
+    handler->verbose_log(1, "Meld function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *FibHeap<Key, Value, Compare, Allocator>::extractMin() {
+    collectPending();
+    Node<Value, Key> *minptr = min;
     if (minptr == nullptr) {
         handler->e_log(17);
         return nullptr;
     }
-    if (minptr->child != nullptr) {
-        int numChildren = minptr->child->size;
-        for (int i = 0; i < numChildren; i++) {
-            Node<T> *child = minptr->child->head;
-            minptr->child->remove(child);
-            rootList.insert(child);
-            child->parent = nullptr;
-        }
+    Node<Value, Key> *child = minptr->child;
+    for (int i = 0; i < minptr->deg; i++) {
+        Node<Value, Key> *next = child->right;
+        rootList.insert(child);
+        child->parent = nullptr;
+        child = next;
     }
-    minptr->left->right = minptr->right;
-    minptr->right->left = minptr->left;
-    if (minptr == minptr->right) {
+    minptr->child = nullptr;
+    minptr->deg = 0;
+    rootList.remove(minptr);
+    if (rootList.head == nullptr)
         min = nullptr;
-        if (minptr->child == nullptr)
-            rootList.remove(minptr);
-    } else {
-        min = minptr->right;
+    else
         consolidate();
-    }
+    index.erase(minptr);
     size--;
 
     handler->verbose_log(1, "ExtractMin function called.");
@@ -195,143 +761,324 @@ Node<T> *FibHeap<T>::extractMin() {
 
 }
 
-template<typename T>
-bool FibHeap<T>::isEmpty() {
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int FibHeap<Key, Value, Compare, Allocator>::extractK(int k, std::vector<handle> &out) {
+    if (k <= 0) return 0;
+    collectPending();
+    if (min == nullptr) {
+        handler->e_log(17);
+        return 0;
+    }
+    auto later = [this](Node<Value, Key> *a, Node<Value, Key> *b) { return comp(b->key, a->key); };
+
+    frontier.clear();
+    Node<Value, Key> *root = rootList.head;
+    do {
+        frontier.push_back(root);
+        root = root->right;
+    } while (root != rootList.head);
+    std::make_heap(frontier.begin(), frontier.end(), later);
+
+    int extracted = 0;
+    while (extracted < k && !frontier.empty()) {
+        std::pop_heap(frontier.begin(), frontier.end(), later);
+        Node<Value, Key> *x = frontier.back();
+        frontier.pop_back();
+
+        Node<Value, Key> *child = x->child;
+        for (int i = 0; i < x->deg; i++) {
+            Node<Value, Key> *next = child->right;
+            rootList.insert(child);
+            child->parent = nullptr;
+            frontier.push_back(child);
+            std::push_heap(frontier.begin(), frontier.end(), later);
+            child = next;
+        }
+        x->child = nullptr;
+        x->deg = 0;
+        rootList.remove(x);
+        if (x->deleted) {
+            allocator.deallocate(x);
+            --tombstones;
+            continue;
+        }
+        index.erase(x);
+        --size;
+        out.push_back(x);
+        ++extracted;
+    }
+
+    if (rootList.head == nullptr)
+        min = nullptr;
+    else
+        consolidate();
+    handler->verbose_log(1, "ExtractK function called.");
+    return extracted;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+std::vector<typename FibHeap<Key, Value, Compare, Allocator>::handle>
+FibHeap<Key, Value, Compare, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    if (rootList.head == nullptr || k <= 0) return result;
+    auto later = [this](Node<Value, Key> *a, Node<Value, Key> *b) { return comp(b->key, a->key); };
+
+    std::vector<Node<Value, Key> *> candidates;
+    Node<Value, Key> *root = rootList.head;
+    do {
+        candidates.push_back(root);
+        root = root->right;
+    } while (root != rootList.head);
+    std::make_heap(candidates.begin(), candidates.end(), later);
+
+    result.reserve(std::min<std::size_t>(k, size));
+    while (static_cast<int>(result.size()) < k && !candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), later);
+        Node<Value, Key> *x = candidates.back();
+        candidates.pop_back();
+        if (!x->deleted)
+            result.push_back(x);
+
+        Node<Value, Key> *child = x->child;
+        for (int i = 0; i < x->deg; i++) {
+            candidates.push_back(child);
+            std::push_heap(candidates.begin(), candidates.end(), later);
+            child = child->right;
+        }
+    }
+    return result;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+bool FibHeap<Key, Value, Compare, Allocator>::isEmpty() {
+    collectPending();
     handler->verbose_log(1, "Is Empty Function called.");
     return size == 0;
 }
 
-template<typename T>
-void FibHeap<T>::consolidate() {
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::consolidate() {
 
     handler->verbose_log(1,"Consolidating Fibonacci Heap...");
 
-    const int fibsize = 45;
-    Node<T> *A[fibsize];
-    Node<T> *x = min;
-    for (int i = 0; i < fibsize; i++)
-        A[i] = nullptr;
-    int iterations = rootList.size;
-    for (int i = 0; i < iterations - 1; i++) {
-        int d = x->deg;
-        while (A[d] != nullptr) {
-            Node<T> *y = A[d];
-            if (x->key > y->key){
-                Node <T> *temp = x;
-                x = y;
-                y = temp;
-            }
-            link(y, x);
-            A[d] = nullptr;
-            ++d;
+    if (tombstones > 0) {
+        dropDeadRoots();
+        if (rootList.head == nullptr) {
+            min = nullptr;
+            return;
         }
-        A[d] = x;
-        x->deg = d;
-        x = x->right;
     }
-    min = nullptr;
-    rootList = DoublyCircularLinkedList<T>();
-    for (int i = 0; i < fibsize; i++) {
-        if (A[i] != nullptr){
-            rootList.insert(A[i]);
-            if (min == nullptr || A[i]->key < min->key)
-                min = A[i];
+
+    // A Fibonacci heap of n nodes has no degree above log_phi(n); dead nodes still count towards n
+    const double logPhi = 0.4812118250596034; // ln((1 + sqrt(5)) / 2)
+    std::size_t maxDegree = static_cast<std::size_t>(std::ceil(std::log(static_cast<double>(size + tombstones)) / logPhi));
+    degreeTable.assign(maxDegree + 1, nullptr);
+
+    // Link roots of equal degree in one pass over the root list, keeping the
+    // survivors where they are and tracking the new minimum as we go
+    int roots = rootList.size;
+    Node<Value, Key> *next = rootList.head;
+    min = next;
+    for (int i = 0; i < roots; i++) {
+        Node<Value, Key> *x = next;
+        next = next->right;
+        std::size_t d = x->deg;
+        while (true) {
+            if (d >= degreeTable.size())
+                degreeTable.resize(d + 1, nullptr);
+            Node<Value, Key> *y = degreeTable[d];
+            if (y == nullptr)
+                break;
+            if (comp(y->key, x->key))
+                std::swap(x, y);
+            link(y, x);
+            if (y == min)
+                min = x;
+            degreeTable[d] = nullptr;
+            ++d;
         }
+        degreeTable[d] = x;
+        if (comp(x->key, min->key))
+            min = x;
     }
 }
 
-template<typename T>
-void FibHeap<T>::link(Node<T> *y, Node<T> *x) {
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::link(Node<Value, Key> *y, Node<Value, Key> *x) {
     rootList.remove(y);
-    if (x->child == nullptr)
-        x->child = new DoublyCircularLinkedList<T>();
-    x->child->insert(y);
+    if (x->child == nullptr) {
+        x->child = y;
+    } else {
+        // Splice y into the child ring just before the first child
+        Node<Value, Key> *first = x->child;
+        y->right = first;
+        y->left = first->left;
+        first->left->right = y;
+        first->left = y;
+    }
+    ++x->deg;
     y->parent = x;
     y->mark = false;
     handler->verbose_log(1, "link function Called.");
 }
 
-template<typename T>
-Node<T> *FibHeap<T>::search(Node<T> *current, int key) const {
-    if (current == nullptr) {
-        handler->verbose_log(1, "Heap Empty.");
-        return nullptr;
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::dropDeadRoots() {
+    dead.clear();
+    int roots = rootList.size;
+    Node<Value, Key> *x = rootList.head;
+    for (int i = 0; i < roots; i++) {
+        if (x->deleted)
+            dead.push_back(x);
+        x = x->right;
     }
-
-
-    Node<T> *start = current;
-    do {
-        if (current->key == key) {
-            return current;
-        }
-        if (current->child != nullptr) {
-            Node<T> *result = search(current->child->head, key);
-            if (result != nullptr) {
-                return result;
-            }
+    // Promoted children join the root list, so dead ones among them are dropped in turn
+    while (!dead.empty()) {
+        x = dead.back();
+        dead.pop_back();
+        Node<Value, Key> *child = x->child;
+        for (int i = 0; i < x->deg; i++) {
+            Node<Value, Key> *next = child->right;
+            rootList.insert(child);
+            child->parent = nullptr;
+            if (child->deleted)
+                dead.push_back(child);
+            child = next;
         }
-        current = current->right;
-    } while (current != start);
-    return nullptr;
+        rootList.remove(x);
+        allocator.deallocate(x);
+        --tombstones;
+    }
+    handler->verbose_log(1, "DropDeadRoots function called.");
 }
 
-template<typename T>
-Node<T> *FibHeap<T>::find(int key) const {
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *FibHeap<Key, Value, Compare, Allocator>::find(Key key) const {
     handler->verbose_log(1, "Search function Called.");
-    return search(rootList.head, key);
+    return index.find(key);
 }
 
-template<typename T>
-void FibHeap<T>::modifyKey(int currentNodeKey, int new_k) {
-    Node<T> *x = find(currentNodeKey);
-    if (find(new_k) != nullptr) {
-        handler->e_log(16);
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::modifyKey(Key currentNodeKey, Key new_k) {
+    collectPending();
+    Node<Value, Key> *x = find(currentNodeKey);
+    if (x == nullptr) {
+        handler->e_log(17);
         return;
     }
     if (x->key == new_k) {
         handler->e_log(15);
         return;
     }
-    if (x == nullptr) {
-        handler->e_log(17);
+    if (find(new_k) != nullptr) {
+        handler->e_log(16);
         return;
     }
-    if (x != nullptr && new_k > x->key) { // Cut from parent and insert into root list
-        modifyKey(x->key, -1);
-        Node<T>* mini = extractMin();
-        mini->key = new_k;
-        insert(mini);
-        handler->verbose_log(1, "ModifyKey function called");
+    if (comp(x->key, new_k))
+        increaseKey(x, new_k);
+    else
+        decreaseKey(x, new_k);
+    handler->verbose_log(1, "ModifyKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::decreaseKey(handle x, Key k) {
+    collectPending();
+    if (comp(x->key, k)) {
+        handler->e_log(1, "New key is greater than the current key.\n");
         return;
     }
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    Node<Value, Key> *y = x->parent;
+    if (y != nullptr && comp(x->key, y->key)) {
+        cut(x, y);
+        cascadingCut(y);
+    }
+    if (comp(x->key, min->key)) {
+        min = x;
+    }
+    handler->verbose_log(1, "DecreaseKey function called");
+}
 
-    x->key = new_k;
-    Node<T> *y = x->parent;
-    if (y != nullptr && x->key < y->key) {
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::increaseKey(handle x, Key k) {
+    collectPending();
+    if (comp(k, x->key)) {
+        handler->e_log(1, "New key is less than the current key.\n");
+        return;
+    }
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    Node<Value, Key> *y = x->parent;
+    if (y != nullptr) {
         cut(x, y);
         cascadingCut(y);
     }
-    if (x->key < min->key) {
-        min=x;
+    // Promote the children, which may now belong above x, next to it in the root list
+    Node<Value, Key> *child = x->child;
+    for (int i = 0; i < x->deg; i++) {
+        Node<Value, Key> *next = child->right;
+        rootList.insert(child);
+        child->parent = nullptr;
+        child->mark = false;
+        child = next;
     }
-    handler->verbose_log(1, "ModifyKey function called");
+    x->child = nullptr;
+    x->deg = 0;
+    if (x == min) {
+        // The new minimum may sit under a dead root, so tombstones are cleared out first
+        if (tombstones > 0)
+            dropDeadRoots();
+        Node<Value, Key> *root = rootList.head;
+        do {
+            if (comp(root->key, min->key))
+                min = root;
+            root = root->right;
+        } while (root != rootList.head);
+    }
+    handler->verbose_log(1, "IncreaseKey function called");
 }
 
-template<typename T>
-void FibHeap<T>::cut(Node<T> *x, Node<T> *y) {
-    y->child->remove(x);
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::erase(handle x) {
+    collectPending();
+    Node<Value, Key> *y = x->parent;
+    if (y != nullptr) {
+        cut(x, y);
+        cascadingCut(y);
+    }
+    // x is now a root; treating it as the minimum lets extractMin remove it
+    min = x;
+    extractMin();
+    handler->verbose_log(1, "Erase function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::cut(Node<Value, Key> *x, Node<Value, Key> *y) {
+    if (x->right == x) {
+        y->child = nullptr;
+    } else {
+        if (y->child == x)
+            y->child = x->right;
+        x->left->right = x->right;
+        x->right->left = x->left;
+    }
+    --y->deg;
     rootList.insert(x);
     x->parent = nullptr;
     x->mark = false;
     handler->verbose_log(1, "Cut Function called.");
 }
 
-template<typename T>
-void FibHeap<T>::cascadingCut(Node<T> *y) {
-    Node<T> *z = y->parent;
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::cascadingCut(Node<Value, Key> *y) {
+    Node<Value, Key> *z = y->parent;
     if (z != nullptr) {
         if (y->mark == false) {
-            y->mark == true;
+            y->mark = true;
         } else {
             cut(y, z);
             cascadingCut(z);
@@ -340,40 +1087,68 @@ void FibHeap<T>::cascadingCut(Node<T> *y) {
     handler->verbose_log(1, "CascadingCut Function called.");
 }
 
-template<typename T>
-void FibHeap<T>::deleteNode(int key) {
-    Node<T> *x = find(key);
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::deleteNode(Key key) {
+    collectPending();
+    Node<Value, Key> *x = find(key);
     if (x == nullptr) {
         // std::cerr << "Node with key " << key << " not found." << std::endl;
         handler->e_log(17);
         return;
     }
-    modifyKey(key, min->key - 1);
-    extractMin();
+    if (lazyDelete) {
+        discard(x);
+    } else {
+        erase(x);
+        destroyNode(x);
+    }
     handler->verbose_log(1, "DeleteNode Function called.");
 }
 
-template<typename T>
-Node<T> *FibHeap<T>::displayMinimum() {
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::setLazyDelete(bool on) {
+    lazyDelete = on;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::discard(handle x) {
+    collectPending();
+    if (x == min) {
+        erase(x);
+        destroyNode(x);
+        return;
+    }
+    index.erase(x);
+    x->deleted = true;
+    --size;
+    ++tombstones;
+    handler->verbose_log(1, "Discard function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *FibHeap<Key, Value, Compare, Allocator>::displayMinimum() {
+    collectPending();
     return this->min;
 }
 
-template<typename T>
-void FibHeap<T>::display() {
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void FibHeap<Key, Value, Compare, Allocator>::display() {
+    collectPending();
     handler->verbose_log(1, "Display Function called.");
     if (!rootList.head) {
         handler->e_log(18);
         return;
     }
 
-    std::function<void(Node<T>*, int)> displayNode = [&](Node<T>* node, int level) {
+    std::function<void(Node<Value, Key>*, int)> displayNode = [&](Node<Value, Key>* node, int level) {
         if (!node) return;
-        Node<T>* start = node;
+        Node<Value, Key>* start = node;
         do {
             for (int i = 0; i < level; ++i) std::cout << "  ";
-            std::cout << "Key: " << node->getKey() << ", Name: " << node->getName() << ", Degree: " << node->getDeg() << std::endl;
+            std::cout << "Key: " << node->getKey() << ", Name: " << node->getName() << ", Degree: " << node->getDeg()
+                      << (node->deleted ? " (deleted)" : "") << std::endl;
             if (node->child) {
-                displayNode(node->child->head, level + 1);
+                displayNode(node->child, level + 1);
             }
             node = node->right;
         } while (node != start);
@@ -382,8 +1157,9 @@ void FibHeap<T>::display() {
     displayNode(rootList.head, 0);
 }
 
-template<typename T>
-int FibHeap<T>::getSize() {
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int FibHeap<Key, Value, Compare, Allocator>::getSize() {
+    collectPending();
     return size;
 }
 
@@ -0,0 +1,506 @@
+#ifndef HOLLOWHEAP_H
+#define HOLLOWHEAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
+#include "error_handler.h"
+
+/**
+ * @class HollowHeap
+ * @brief Represents a two-parent hollow heap with the same interface as FibHeap.
+ *
+ * Nodes of the heap are cells kept in one array and addressed by index. A cell
+ * either holds a node (full) or has given its node away (hollow). decreaseKey
+ * never cuts: it moves the node into a fresh cell that takes the old one as its
+ * child and links the new cell with the root, so it is one comparison. erase
+ * only hollows the node's cell; hollow cells are cleaned up the next time the
+ * root itself is hollowed, where the survivors are combined by ranked links.
+ * Every node keeps the index of its current cell in slot.
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Compare Strict weak ordering on keys; the node that compares first is the minimum.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key>,
+    template<typename> class Allocator = NodePool>
+class HollowHeap : public KeyedHeap<HollowHeap<Key, Value, Compare, Allocator>, Key, Value, 8, Compare> {
+private:
+    using Keyed = KeyedHeap<HollowHeap, Key, Value, 8, Compare>;
+    friend Keyed;
+
+    /**
+     * @brief A cell of the heap. Links are indices into cells, -1 meaning none.
+     */
+    struct Cell {
+        Key key; ///< The key the cell was created with.
+        Node<Value, Key> *item; ///< The node held by the cell, or null once the cell is hollow.
+        int child; ///< First child.
+        int next; ///< Next sibling in the first parent's child list.
+        int ep; ///< Second parent of a hollow cell, or -1.
+        int rank; ///< Rank used by ranked links.
+    };
+
+    std::vector<Cell> cells; ///< Storage for every cell; hollow cells stay until the root is hollowed.
+    std::vector<int> freeCells; ///< Released cell indices waiting to be reused.
+    std::vector<int> rankTable; ///< Scratch table of one full root per rank, used while rebuilding.
+    int root; ///< Index of the root cell, which holds the minimum key, or -1.
+    int size; ///< Number of nodes in the heap.
+    KeyIndex<Key, Value> index; ///< Key to node index backing find().
+    error_handler *handler;
+    Compare comp; ///< Key ordering; comp(a, b) means a belongs above b.
+    Allocator<Node<Value, Key> > allocator; ///< Storage for every node created through this heap.
+
+    /**
+     * @brief Puts a node into a new cell and records the cell in the node's slot.
+     *
+     * @param x The node to hold.
+     * @param key The key of the new cell.
+     * @return int The index of the new cell.
+     */
+    int makeCell(Node<Value, Key> *x, Key key);
+
+    /**
+     * @brief Links two root cells, making the one with the larger key the first child of the other.
+     *
+     * @param v The first root.
+     * @param w The second root.
+     * @return int The root of the linked tree.
+     */
+    int link(int v, int w);
+
+    /**
+     * @brief Hollows the root and rebuilds the heap from its full descendants.
+     *
+     * Hollow cells whose only parent is being destroyed are destroyed too; full
+     * cells are combined by ranked links and the survivors are linked into one tree.
+     */
+    void rebuild();
+
+public:
+    /**
+     * @brief Stable reference to a node in the heap.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
+    /**
+     * @brief Constructs a new, empty hollow heap.
+     */
+    HollowHeap(error_handler *handler);
+
+    /**
+     * @brief Destroys the heap and releases every node still in it.
+     */
+    ~HollowHeap();
+
+    HollowHeap(const HollowHeap &) = delete;
+    HollowHeap &operator=(const HollowHeap &) = delete;
+
+    /**
+     * @brief Allocates a node from the heap's allocator without inserting it.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The new node.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the heap to the allocator.
+     *
+     * @param x The node to release. Null is ignored.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the heap.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the heap.
+     *
+     * @param x The node to be inserted.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the heap.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Lowers the key of a node by moving it into a new cell linked with the root.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be greater than the current one.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node by hollowing its cell and inserting it again.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be less than the current one.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the heap without searching for it.
+     *
+     * Only the node's cell is hollowed unless it is the root.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another heap into this one by moving the smaller cell array over and linking the roots.
+     *
+     * @param other The heap to meld into this one. It is left empty.
+     */
+    void meld(HollowHeap &&other);
+
+    /**
+     * @brief Extracts the minimum node from the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the heap.
+     *
+     * @param k The number of nodes to list.
+     * @return std::vector<handle> Up to k nodes in increasing key order.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the minimum node in the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Displays the structure of the heap, hollow cells included.
+     */
+    void display();
+
+    /**
+     * @brief Checks if the heap is empty.
+     *
+     * @return true If the heap is empty.
+     * @return false If the heap is not empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the heap.
+     *
+     * @return int The number of nodes in the heap.
+     */
+    int getSize();
+};
+
+// Implementation of the HollowHeap template class
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+HollowHeap<Key, Value, Compare, Allocator>::HollowHeap(error_handler *handler)
+    : root(-1), size(0), handler(handler) {}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+HollowHeap<Key, Value, Compare, Allocator>::~HollowHeap() {
+    clear();
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename HollowHeap<Key, Value, Compare, Allocator>::handle
+HollowHeap<Key, Value, Compare, Allocator>::createNode(Value Name, Key key) {
+    return allocator.allocate(Name, key);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void HollowHeap<Key, Value, Compare, Allocator>::destroyNode(handle x) {
+    allocator.deallocate(x);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void HollowHeap<Key, Value, Compare, Allocator>::clear() {
+    if constexpr (Allocator<Node<Value, Key> >::bulk_release && std::is_trivially_destructible<Node<Value, Key> >::value) {
+        allocator.release();
+    } else {
+        for (const Cell &cell: cells)
+            allocator.deallocate(cell.item);
+    }
+    cells.clear();
+    freeCells.clear();
+    root = -1;
+    index.clear();
+    size = 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int HollowHeap<Key, Value, Compare, Allocator>::makeCell(Node<Value, Key> *x, Key key) {
+    int i;
+    if (!freeCells.empty()) {
+        i = freeCells.back();
+        freeCells.pop_back();
+        cells[i] = {key, x, -1, -1, -1, 0};
+    } else {
+        i = static_cast<int>(cells.size());
+        cells.push_back({key, x, -1, -1, -1, 0});
+    }
+    x->slot = i;
+    return i;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int HollowHeap<Key, Value, Compare, Allocator>::link(int v, int w) {
+    if (comp(cells[w].key, cells[v].key))
+        std::swap(v, w);
+    cells[w].next = cells[v].child;
+    cells[v].child = w;
+    return v;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void HollowHeap<Key, Value, Compare, Allocator>::rebuild() {
+    int maxRank = -1;
+    int h = root;
+    cells[h].next = -1;
+    while (h != -1) {
+        int w = cells[h].child;
+        int v = h;
+        h = cells[h].next;
+        while (w != -1) {
+            int u = w;
+            w = cells[w].next;
+            if (cells[u].item == nullptr) {
+                if (cells[u].ep == -1) {
+                    // v was the only parent, so u goes too
+                    cells[u].next = h;
+                    h = u;
+                } else {
+                    // u survives under its other parent, where it is the last child
+                    if (cells[u].ep == v)
+                        w = -1;
+                    else
+                        cells[u].next = -1;
+                    cells[u].ep = -1;
+                }
+            } else {
+                int r = cells[u].rank;
+                if (static_cast<int>(rankTable.size()) <= r + 1)
+                    rankTable.resize(r + 2, -1);
+                while (rankTable[r] != -1) {
+                    u = link(u, rankTable[r]);
+                    rankTable[r] = -1;
+                    cells[u].rank = ++r;
+                    if (static_cast<int>(rankTable.size()) <= r + 1)
+                        rankTable.resize(r + 2, -1);
+                }
+                rankTable[r] = u;
+                maxRank = std::max(maxRank, r);
+            }
+        }
+        freeCells.push_back(v);
+    }
+
+    root = -1;
+    for (int r = 0; r <= maxRank; r++) {
+        if (rankTable[r] != -1) {
+            root = root == -1 ? rankTable[r] : link(root, rankTable[r]);
+            rankTable[r] = -1;
+        }
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename HollowHeap<Key, Value, Compare, Allocator>::handle
+HollowHeap<Key, Value, Compare, Allocator>::insert(Node<Value, Key> *x) {
+    int cell = makeCell(x, x->key);
+    root = root == -1 ? cell : link(root, cell);
+    index.insert(x);
+    ++size;
+    handler->verbose_log(8, "Insert function called.");
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename HollowHeap<Key, Value, Compare, Allocator>::handle
+HollowHeap<Key, Value, Compare, Allocator>::insert(Value Name, Key key) {
+    return insert(createNode(Name, key));
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void HollowHeap<Key, Value, Compare, Allocator>::decreaseKey(handle x, Key k) {
+    if (comp(x->key, k)) {
+        handler->e_log(8, "New key is greater than the current key.\n");
+        return;
+    }
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+
+    int u = x->slot;
+    if (u == root) {
+        cells[u].key = k;
+    } else {
+        int v = makeCell(x, k);
+        cells[u].item = nullptr;
+        cells[v].rank = std::max(0, cells[u].rank - 2);
+        cells[v].child = u;
+        cells[u].ep = v;
+        root = link(root, v);
+    }
+    handler->verbose_log(8, "DecreaseKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void HollowHeap<Key, Value, Compare, Allocator>::increaseKey(handle x, Key k) {
+    if (comp(k, x->key)) {
+        handler->e_log(8, "New key is less than the current key.\n");
+        return;
+    }
+    erase(x);
+    x->key = k;
+    insert(x);
+    handler->verbose_log(8, "IncreaseKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void HollowHeap<Key, Value, Compare, Allocator>::erase(handle x) {
+    int u = x->slot;
+    cells[u].item = nullptr;
+    index.erase(x);
+    --size;
+    if (u == root)
+        rebuild();
+    handler->verbose_log(8, "Erase function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void HollowHeap<Key, Value, Compare, Allocator>::meld(HollowHeap &&other) {
+    if (&other == this || other.root == -1) return;
+
+    if (cells.size() < other.cells.size()) {
+        cells.swap(other.cells);
+        freeCells.swap(other.freeCells);
+        std::swap(root, other.root);
+    }
+    int offset = static_cast<int>(cells.size());
+    for (Cell cell: other.cells) {
+        if (cell.child != -1) cell.child += offset;
+        if (cell.next != -1) cell.next += offset;
+        if (cell.ep != -1) cell.ep += offset;
+        if (cell.item != nullptr) cell.item->slot += offset;
+        cells.push_back(cell);
+    }
+    for (int i: other.freeCells)
+        freeCells.push_back(i + offset);
+    int otherRoot = other.root + offset;
+    root = root == -1 ? otherRoot : link(root, otherRoot);
+
+    size += other.size;
+    index.merge(other.index);
+    allocator.merge(other.allocator);
+    other.cells.clear();
+    other.freeCells.clear();
+    other.root = -1;
+    other.size = 0;
+    handler->verbose_log(8, "Meld function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *HollowHeap<Key, Value, Compare, Allocator>::extractMin() {
+    if (root == -1) {
+        handler->e_log(Keyed::notFound);
+        return nullptr;
+    }
+    Node<Value, Key> *minptr = cells[root].item;
+    erase(minptr);
+    handler->verbose_log(8, "ExtractMin function called.");
+    return minptr;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+std::vector<typename HollowHeap<Key, Value, Compare, Allocator>::handle>
+HollowHeap<Key, Value, Compare, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    if (root == -1 || k <= 0) return result;
+    auto later = [this](int a, int b) { return comp(cells[b].key, cells[a].key); };
+
+    std::vector<int> candidates(1, root);
+    result.reserve(std::min(k, size));
+    while (static_cast<int>(result.size()) < k && !candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), later);
+        int v = candidates.back();
+        candidates.pop_back();
+        if (cells[v].item != nullptr)
+            result.push_back(cells[v].item);
+
+        // A cell with two parents is reached through its first parent only
+        for (int w = cells[v].child; w != -1 && cells[w].ep != v; w = cells[w].next) {
+            candidates.push_back(w);
+            std::push_heap(candidates.begin(), candidates.end(), later);
+        }
+    }
+    return result;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *HollowHeap<Key, Value, Compare, Allocator>::displayMinimum() {
+    return root == -1 ? nullptr : cells[root].item;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void HollowHeap<Key, Value, Compare, Allocator>::display() {
+    handler->verbose_log(8, "Display Function called.");
+    if (root == -1) {
+        handler->e_log(Keyed::emptyHeap);
+        return;
+    }
+
+    std::function<void(int, int)> displayCell = [&](int v, int level) {
+        for (int w = cells[v].child; w != -1 && cells[w].ep != v; w = cells[w].next) {
+            for (int i = 0; i < level; ++i) std::cout << "  ";
+            if (cells[w].item != nullptr)
+                std::cout << "Key: " << cells[w].key << ", Name: " << cells[w].item->getName() << std::endl;
+            else
+                std::cout << "Key: " << cells[w].key << " (hollow)" << std::endl;
+            displayCell(w, level + 1);
+        }
+    };
+
+    std::cout << "Key: " << cells[root].key << ", Name: " << cells[root].item->getName() << std::endl;
+    displayCell(root, 1);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+bool HollowHeap<Key, Value, Compare, Allocator>::isEmpty() {
+    return size == 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int HollowHeap<Key, Value, Compare, Allocator>::getSize() {
+    return size;
+}
+
+#endif // HOLLOWHEAP_H
@@ -1,33 +1,104 @@
 #ifndef HOSPITALTASKMANAGER_H
 #define HOSPITALTASKMANAGER_H
 
+#include "BinomialHeap.h"
 #include "FibHeap.h"
+#include "MpscRing.h"
 #include "Node.h"
+#include "PriorityQueue.h"
+#include "RadixHeap.h"
 #include"../src/_env.h"
 
 #include <iostream>
 #include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "error_handler.h"
 
 // Forward Declaration
 class VisualizeTaskManager;
 
+/**
+ * @brief Picks the heap engine for a task manager.
+ *
+ * A queue is monotone when no task is ever added or re-prioritized below the
+ * priority of the last completed task. Such queues can use the radix heap;
+ * all others use the Fibonacci heap.
+ *
+ * @tparam Monotone Whether the queue's priorities are declared monotone.
+ */
+template<bool Monotone>
+using TaskHeap = std::conditional_t<Monotone, RadixHeap<int, std::string>, FibHeap<int, std::string> >;
+
+/**
+ * @class HospitalTaskManager
+ * @brief Manages prioritized hospital tasks on top of a heap engine.
+ *
+ * @tparam Engine The heap that stores the tasks. Any type satisfying IsPriorityQueue
+ * with int keys and std::string names works, e.g. FibHeap or PairingHeap. Queues
+ * with a per-operation latency bound should use BinomialHeap, whose operations are
+ * bounded in the worst case rather than amortized. Queues whose priorities stay in
+ * a small known range can use BucketQueue for O(1) operations.
+ *
+ * The engine belongs to one owning thread, e.g. the GUI loop. Other threads hand
+ * work to it through submitTask() and submitPriorityUpdate(), which only touch a
+ * lock-free admission ring; the owner applies everything queued so far with
+ * drainAdmissions() once per frame or tick. The ring is the only cross-thread
+ * path: the default engine allocates from a NodePool, which is not thread-safe,
+ * so it cannot take FibHeap::post() directly.
+ */
+template<typename Engine = FibHeap<int, std::string> >
 class HospitalTaskManager {
 private:
-    FibHeap<std::string> *taskHeap;
+    static_assert(IsPriorityQueue<Engine>::value, "HospitalTaskManager needs a priority-queue engine");
+
+    using TaskNode = Node<typename Engine::value_type, typename Engine::key_type>;
+
+    /**
+     * @brief A task or priority change waiting in the admission ring.
+     */
+    struct Admission {
+        bool update = false; ///< false for a new task, true for a priority change.
+        std::string description;
+        int priority = 0; ///< The new task's priority, or the priority to change.
+        int newPriority = 0;
+        Patient *patient = nullptr;
+    };
+
+    static constexpr std::size_t admissionCapacity = 256; ///< Requests that can wait between two drains.
+
+    Engine *taskHeap;
     error_handler *handler;
 
+    MpscRing<Admission, admissionCapacity> admissions;
+    Admission request; ///< Receives each popped request; an admitted description is moved on into batch.
+    std::vector<std::pair<std::string, int> > batch; ///< Validated tasks not yet in the engine.
+    std::vector<Patient *> batchPatients; ///< Patient of each entry in batch.
+    std::unordered_set<int> batchPriorities; ///< Priorities taken by entries in batch.
+
+    /**
+     * @brief Moves the validated batch into the engine, in one insertRange() call if the engine has one.
+     */
+    void admitBatch();
+
 public:
-    HospitalTaskManager(FibHeap<std::string> *taskHeap, error_handler *handler): taskHeap(taskHeap), handler(handler) {
+    HospitalTaskManager(Engine *taskHeap, error_handler *handler): taskHeap(taskHeap), handler(handler) {
+        // Size the engine for a full queue up front so no task operation has to grow it
+        if constexpr (HasReserve<Engine>::value)
+            taskHeap->reserve(MAX_TASKS);
     };
 
     friend class VisualizeTaskManager;
 
     ~HospitalTaskManager() {
+        // Requests still in the ring own their patients; nobody else will free them
+        while (admissions.pop(request))
+            delete request.patient;
         while (!taskHeap->isEmpty()) {
-            Node<std::string> *task = taskHeap->extractMin();
-            delete task;
+            taskHeap->destroyNode(taskHeap->extractMin());
         }
     }
 
@@ -44,25 +115,26 @@ public:
             handler->e_log(02);
             return;
         }
-        Node<std::string> *newNode = new Node<std::string>(description, priority);
+        TaskNode *newNode = taskHeap->insert(description, priority);
+        if (newNode == nullptr)
+            return; // The engine rejected the priority and logged why
         newNode->setData(patient);
-        taskHeap->insert(newNode);
         handler->verbose_log(0, "Task added: " + description);
     }
 
     void completeHighestPriorityTask() {
-        Node<std::string> *highestPriorityTask = taskHeap->extractMin();
+        TaskNode *highestPriorityTask = taskHeap->extractMin();
 
         if (highestPriorityTask == nullptr) {
             handler->e_log(04);
             return;
         }
         handler->verbose_log(0, "Completed task: " + highestPriorityTask->getName());
-        delete highestPriorityTask;
+        taskHeap->destroyNode(highestPriorityTask);
     }
 
     void updateTaskPriority(int oldPriority, int newPriority) {
-        Node<std::string> *taskNode = taskHeap->find(oldPriority);
+        TaskNode *taskNode = taskHeap->find(oldPriority);
         if (taskNode == nullptr) {
             handler->e_log(04);
             return;
@@ -83,6 +155,56 @@ public:
         handler->verbose_log(0, "Task priority updated: " + taskNode->getName());
     }
 
+    /**
+     * @brief Queues a new task for the owning thread. Safe to call from any thread.
+     *
+     * The task is checked and added by the next drainAdmissions(), which logs any
+     * rejection the way addTask() does.
+     *
+     * Once queued, the patient belongs to the manager: it is deleted if the task is
+     * rejected or the manager is destroyed before the request is drained. If the
+     * ring is full nothing is queued and the caller keeps the patient.
+     *
+     * @param description The task name.
+     * @param priority The task priority.
+     * @param patient Optional patient attached to the task, allocated with new.
+     * @return true if the request was queued, false if the admission ring was full.
+     */
+    bool submitTask(const std::string &description, int priority, Patient *patient = nullptr) {
+        Admission a;
+        a.description = description;
+        a.priority = priority;
+        a.patient = patient;
+        return admissions.push(std::move(a));
+    }
+
+    /**
+     * @brief Queues a priority change for the owning thread. Safe to call from any thread.
+     *
+     * @param oldPriority The priority of the task to change.
+     * @param newPriority The priority to give it.
+     * @return true if the request was queued, false if the admission ring was full.
+     */
+    bool submitPriorityUpdate(int oldPriority, int newPriority) {
+        Admission a;
+        a.update = true;
+        a.priority = oldPriority;
+        a.newPriority = newPriority;
+        return admissions.push(std::move(a));
+    }
+
+    /**
+     * @brief Applies the queued requests in submission order. Only the owning thread may call this.
+     *
+     * New tasks are validated as in addTask() and collected into a batch that is
+     * inserted in one go. A priority change first flushes the batch, so it can
+     * target a task submitted just before it. At most one ring's worth of requests
+     * is taken per call, so busy producers cannot stretch a frame.
+     *
+     * @return int The number of requests taken from the ring.
+     */
+    int drainAdmissions();
+
     int countTasks() {
         return taskHeap->getSize();
     }
@@ -92,8 +214,8 @@ public:
         taskHeap->display();
     }
 
-    Node<std::string> *getTaskCopy(int Priority) {
-        Node<std::string> *taskNode = taskHeap->find(Priority);
+    TaskNode *getTaskCopy(int Priority) {
+        TaskNode *taskNode = taskHeap->find(Priority);
 
         if (taskNode == nullptr) {
             handler->e_log(04); // Log error if the node is not found
@@ -101,7 +223,7 @@ public:
         }
 
         // Create a deep copy of the node
-        Node<std::string> *taskCopy = new Node<std::string>(taskNode->getName(), taskNode->getKey());
+        TaskNode *taskCopy = new TaskNode(taskNode->getName(), taskNode->getKey());
         if (taskNode->getData() != nullptr) {
             taskCopy->setData(new Patient(taskNode->getData()->getDescription(),taskNode->getData()->getAge(), taskNode->getData()->getGender() )); // Deep copy of the Patient data
         }
@@ -110,4 +232,69 @@ public:
     }
 };
 
+// Implementation of the HospitalTaskManager template class
+
+template<typename Engine>
+void HospitalTaskManager<Engine>::admitBatch() {
+    if (batch.empty())
+        return;
+    if constexpr (HasInsertRange<Engine>::value) {
+        taskHeap->insertRange(batch.begin(), batch.end());
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            if (batchPatients[i] == nullptr)
+                continue;
+            if (TaskNode *newNode = taskHeap->find(batch[i].second))
+                newNode->setData(batchPatients[i]);
+            else
+                delete batchPatients[i];
+        }
+    } else {
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            TaskNode *newNode = taskHeap->insert(batch[i].first, batch[i].second);
+            if (newNode != nullptr)
+                newNode->setData(batchPatients[i]);
+            else
+                delete batchPatients[i]; // The engine rejected the priority and logged why
+        }
+    }
+    handler->verbose_log(0, "Tasks admitted: " + std::to_string(batch.size()));
+    batch.clear();
+    batchPatients.clear();
+    batchPriorities.clear();
+}
+
+template<typename Engine>
+int HospitalTaskManager<Engine>::drainAdmissions() {
+    int drained = 0;
+    while (drained < static_cast<int>(admissionCapacity) && admissions.pop(request)) {
+        ++drained;
+        if (request.update) {
+            admitBatch();
+            updateTaskPriority(request.priority, request.newPriority);
+            continue;
+        }
+        if (request.priority < 0) {
+            handler->e_log(00);
+            delete request.patient;
+            continue;
+        }
+        if (batchPriorities.count(request.priority) != 0 || taskHeap->find(request.priority) != nullptr) {
+            handler->e_log(01);
+            delete request.patient;
+            continue;
+        }
+        if (request.description.empty() || request.description.length() > 50 ||
+            taskHeap->getSize() + static_cast<int>(batch.size()) >= MAX_TASKS) {
+            handler->e_log(02);
+            delete request.patient;
+            continue;
+        }
+        batch.emplace_back(std::move(request.description), request.priority);
+        batchPatients.push_back(request.patient);
+        batchPriorities.insert(request.priority);
+    }
+    admitBatch();
+    return drained;
+}
+
 #endif
@@ -0,0 +1,59 @@
+#ifndef KEYHASH_H
+#define KEYHASH_H
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+/**
+ * @class KeyHash
+ * @brief Hash used by the heaps' key indexes.
+ *
+ * Forwards to std::hash for scalar keys and combines the element hashes for
+ * std::pair and std::tuple keys, so composite keys such as (severity, arrival)
+ * can be indexed without a user-supplied hash.
+ *
+ * @tparam Key The key type to hash.
+ */
+template<typename Key>
+struct KeyHash {
+    std::size_t operator()(const Key &key) const {
+        return std::hash<Key>()(key);
+    }
+};
+
+/**
+ * @brief Mixes one more hash value into a running seed.
+ *
+ * @param seed The running hash.
+ * @param value The hash to mix in.
+ * @return std::size_t The combined hash.
+ */
+inline std::size_t combineKeyHash(std::size_t seed, std::size_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+template<typename First, typename Second>
+struct KeyHash<std::pair<First, Second> > {
+    std::size_t operator()(const std::pair<First, Second> &key) const {
+        return combineKeyHash(KeyHash<First>()(key.first), KeyHash<Second>()(key.second));
+    }
+};
+
+template<typename... Elements>
+struct KeyHash<std::tuple<Elements...> > {
+    std::size_t operator()(const std::tuple<Elements...> &key) const {
+        return hashElements(key, std::index_sequence_for<Elements...>());
+    }
+
+private:
+    template<std::size_t... I>
+    static std::size_t hashElements(const std::tuple<Elements...> &key, std::index_sequence<I...>) {
+        std::size_t seed = 0;
+        ((seed = combineKeyHash(seed, KeyHash<Elements>()(std::get<I>(key)))), ...);
+        return seed;
+    }
+};
+
+#endif // KEYHASH_H
@@ -0,0 +1,108 @@
+#ifndef MPSCRING_H
+#define MPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+ * @class MpscRing
+ * @brief Bounded lock-free queue with many producers and a single consumer.
+ *
+ * Every cell carries a sequence number that tells its owner what the cell holds.
+ * Producers claim a position with one CAS on the shared tail, fill the cell and
+ * then publish it by bumping its sequence. The single consumer reads cells in
+ * order and hands each one back to the producers one lap later, so it never needs
+ * an atomic read-modify-write. A producer that is stopped between claiming and
+ * publishing holds up the consumer at that cell, but no other producer.
+ *
+ * @tparam T The element type, which must be default constructible and movable.
+ * @tparam Capacity The number of cells, which must be a power of two.
+ */
+template<typename T, std::size_t Capacity>
+class MpscRing {
+private:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MpscRing capacity must be a power of two");
+
+    static constexpr std::size_t mask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence; ///< pos when free for the producer at pos, pos + 1 once published.
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<std::size_t> tail{0}; ///< Next position a producer will claim.
+    alignas(64) std::size_t head = 0; ///< Next position the consumer will read; only the consumer touches it.
+
+public:
+    MpscRing(): cells(new Cell[Capacity]) {
+        for (std::size_t i = 0; i < Capacity; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing &) = delete;
+
+    MpscRing &operator=(const MpscRing &) = delete;
+
+    /**
+     * @brief Appends an element. Safe to call from any number of threads at once.
+     *
+     * @param item The element to store.
+     * @return true if the element was queued, false if the ring was full.
+     */
+    template<typename U>
+    bool push(U &&item);
+
+    /**
+     * @brief Removes the oldest published element. Only the consumer thread may call this.
+     *
+     * @param out Receives the element.
+     * @return true if an element was removed, false if none was published yet.
+     */
+    bool pop(T &out);
+
+    /**
+     * @brief Returns how many elements the ring can hold.
+     */
+    static constexpr std::size_t capacity() { return Capacity; }
+};
+
+// Implementation of the MpscRing template class
+
+template<typename T, std::size_t Capacity>
+template<typename U>
+bool MpscRing<T, Capacity>::push(U &&item) {
+    std::size_t pos = tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell &cell = cells[pos & mask];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(sequence - pos);
+        if (lag == 0) {
+            // The cell is free for this lap; claim it before writing
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.value = std::forward<U>(item);
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (lag < 0) {
+            return false; // The consumer has not freed this cell from the last lap
+        } else {
+            pos = tail.load(std::memory_order_relaxed); // Another producer took pos
+        }
+    }
+}
+
+template<typename T, std::size_t Capacity>
+bool MpscRing<T, Capacity>::pop(T &out) {
+    Cell &cell = cells[head & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != head + 1)
+        return false;
+    out = std::move(cell.value);
+    cell.sequence.store(head + Capacity, std::memory_order_release);
+    ++head;
+    return true;
+}
+
+#endif // MPSCRING_H
@@ -0,0 +1,581 @@
+#ifndef MULTIQUEUE_H
+#define MULTIQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "FibHeap.h"
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
+#include "error_handler.h"
+
+/**
+ * @class MultiQueue
+ * @brief Relaxed concurrent priority queue made of c * P independently locked FibHeap shards.
+ *
+ * insert puts a node into a random shard. extractMin looks at the cached
+ * minima of two random shards and pops from the better one, so threads rarely
+ * meet on the same lock and throughput grows with the number of cores. The
+ * price is ordering: a node may come out while smaller ones wait in other
+ * shards. Every 64th extraction of each thread is checked against the cached
+ * minima of all shards, and the number of shards holding something smaller is
+ * reported as the rank error. It is a lower bound on how many nodes were
+ * skipped.
+ *
+ * A node stays in the shard that allocated it, whose index it keeps in slot,
+ * so handle operations lock just that shard. Keys are published through
+ * std::atomic and must be trivially copyable.
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Compare Strict weak ordering on keys; the node that compares first is the minimum.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key>,
+    template<typename> class Allocator = NodePool>
+class MultiQueue : private HeapErrorCodes<15> {
+    static_assert(std::is_trivially_copyable<Key>::value, "MultiQueue publishes shard minima through std::atomic<Key>");
+
+private:
+    /**
+     * @brief One shard: a FibHeap behind its own lock, with its minimum published for lock-free peeking.
+     */
+    struct alignas(64) Shard {
+        std::mutex lock; ///< Guards heap.
+        std::atomic<Key> top; ///< Minimum key of heap, meaningful while count is positive.
+        std::atomic<int> count{0}; ///< Size of heap as of the last change.
+        FibHeap<Key, Value, Compare, Allocator> heap;
+
+        Shard(error_handler *handler) : top(Key{}), heap(handler) {}
+    };
+
+    static constexpr int sampleInterval = 64; ///< Each thread measures the rank error of one extraction in this many.
+
+    std::vector<std::unique_ptr<Shard> > shards;
+    error_handler *handler;
+    Compare comp; ///< Key ordering; comp(a, b) means a belongs above b.
+    std::atomic<long long> samples{0}; ///< Extractions whose rank error was measured.
+    std::atomic<long long> rankErrorSum{0}; ///< Sum of the measured rank errors.
+    std::atomic<int> rankErrorMax{0}; ///< Largest measured rank error.
+
+    /**
+     * @brief Draws a shard index from a per-thread xorshift generator.
+     */
+    int randomShard() const;
+
+    /**
+     * @brief Republishes a shard's minimum and size. Called with the shard locked.
+     */
+    void publish(Shard &s);
+
+    /**
+     * @brief Checks whether shard a's published minimum beats shard b's; empty shards never win.
+     */
+    bool better(const Shard &a, const Shard &b) const;
+
+    /**
+     * @brief Counts shards whose published minimum comes before key and records it as a rank error sample.
+     */
+    void sampleRankError(Key key);
+
+    /**
+     * @brief Points slot of every node in a shard's heap at shard index i by walking its trees once.
+     */
+    static void relabel(Shard &s, int i);
+
+public:
+    /**
+     * @brief Stable reference to a node in the heap.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
+    /**
+     * @brief Constructs an empty MultiQueue.
+     *
+     * @param handler The error handler used for logging.
+     * @param c Shards per thread; 2 or more keeps two-choice extraction off each other's locks.
+     * @param threads Expected number of threads P, or 0 to use the hardware concurrency.
+     */
+    MultiQueue(error_handler *handler, int c = 2, int threads = 0);
+
+    MultiQueue(const MultiQueue &) = delete;
+    MultiQueue &operator=(const MultiQueue &) = delete;
+
+    /**
+     * @brief Gets the number of shards.
+     */
+    int shardCount() const;
+
+    /**
+     * @brief Allocates a node in a random shard without inserting it.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the queue to its shard's allocator.
+     *
+     * @param x The node to release. Null is ignored.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the queue.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the shard that allocated it.
+     *
+     * @param x The node to be inserted.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into a random shard.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Lowers the key of a node, locking only its shard.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node, locking only its shard.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the queue without searching for it.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another MultiQueue into this one, shard by shard.
+     *
+     * The other queue must not be in use by other threads.
+     *
+     * @param other The queue to meld into this one. It is left empty.
+     */
+    void meld(MultiQueue &&other);
+
+    /**
+     * @brief Pops the better minimum of two random shards.
+     *
+     * @return Node<Value, Key>* A node close to the minimum, or nullptr if every shard is empty.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order, locking every shard for the duration.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Finds the exact minimum across all shards.
+     *
+     * @return Node<Value, Key>* The minimum node at the time of the call.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Modifies the key of a node.
+     *
+     * Every shard is locked for the duration, so no other thread can take the
+     * new key between the check and the change.
+     */
+    void modifyKey(Key k, Key new_k);
+
+    /**
+     * @brief Deletes a node with a specific key from the queue and frees it.
+     */
+    void deleteNode(Key k);
+
+    /**
+     * @brief Displays every shard in turn.
+     */
+    void display();
+
+    /**
+     * @brief Finds a node with a specific key in any shard.
+     */
+    Node<Value, Key> *find(Key key) const;
+
+    /**
+     * @brief Checks if every shard was empty as of its last change.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the total size as of each shard's last change.
+     */
+    int getSize();
+
+    /**
+     * @brief Gets the mean measured rank error, in shards holding a smaller key than the one extracted.
+     */
+    double meanRankError() const;
+
+    /**
+     * @brief Gets the largest measured rank error.
+     */
+    int maxRankError() const;
+};
+
+// Implementation of the MultiQueue template class
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+MultiQueue<Key, Value, Compare, Allocator>::MultiQueue(error_handler *handler, int c, int threads)
+    : handler(handler) {
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    int count = std::max(1, c) * threads;
+    shards.reserve(count);
+    for (int i = 0; i < count; i++)
+        shards.push_back(std::make_unique<Shard>(handler));
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int MultiQueue<Key, Value, Compare, Allocator>::shardCount() const {
+    return static_cast<int>(shards.size());
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int MultiQueue<Key, Value, Compare, Allocator>::randomShard() const {
+    thread_local std::uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<int>(state % shards.size());
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::publish(Shard &s) {
+    Node<Value, Key> *min = s.heap.displayMinimum();
+    if (min != nullptr)
+        s.top.store(min->key, std::memory_order_relaxed);
+    s.count.store(s.heap.getSize(), std::memory_order_release);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+bool MultiQueue<Key, Value, Compare, Allocator>::better(const Shard &a, const Shard &b) const {
+    if (a.count.load(std::memory_order_acquire) == 0) return false;
+    if (b.count.load(std::memory_order_acquire) == 0) return true;
+    return comp(a.top.load(std::memory_order_relaxed), b.top.load(std::memory_order_relaxed));
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::sampleRankError(Key key) {
+    int error = 0;
+    for (const auto &s: shards) {
+        if (s->count.load(std::memory_order_acquire) > 0 && comp(s->top.load(std::memory_order_relaxed), key))
+            ++error;
+    }
+    samples.fetch_add(1, std::memory_order_relaxed);
+    rankErrorSum.fetch_add(error, std::memory_order_relaxed);
+    int seen = rankErrorMax.load(std::memory_order_relaxed);
+    while (error > seen && !rankErrorMax.compare_exchange_weak(seen, error, std::memory_order_relaxed)) {
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::relabel(Shard &s, int i) {
+    Node<Value, Key> *root = s.heap.displayMinimum();
+    if (root == nullptr) return;
+    std::vector<Node<Value, Key> *> siblings{root};
+    while (!siblings.empty()) {
+        Node<Value, Key> *first = siblings.back();
+        siblings.pop_back();
+        Node<Value, Key> *x = first;
+        do {
+            x->slot = i;
+            if (x->child != nullptr)
+                siblings.push_back(x->child);
+            x = x->right;
+        } while (x != first);
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename MultiQueue<Key, Value, Compare, Allocator>::handle
+MultiQueue<Key, Value, Compare, Allocator>::createNode(Value Name, Key key) {
+    int i = randomShard();
+    Shard &s = *shards[i];
+    std::lock_guard<std::mutex> guard(s.lock);
+    handle x = s.heap.createNode(Name, key);
+    x->slot = i;
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::destroyNode(handle x) {
+    if (x == nullptr) return;
+    Shard &s = *shards[x->slot];
+    std::lock_guard<std::mutex> guard(s.lock);
+    s.heap.destroyNode(x);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::clear() {
+    for (auto &s: shards) {
+        std::lock_guard<std::mutex> guard(s->lock);
+        s->heap.clear();
+        publish(*s);
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename MultiQueue<Key, Value, Compare, Allocator>::handle
+MultiQueue<Key, Value, Compare, Allocator>::insert(Node<Value, Key> *x) {
+    Shard &s = *shards[x->slot];
+    std::lock_guard<std::mutex> guard(s.lock);
+    s.heap.insert(x);
+    publish(s);
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename MultiQueue<Key, Value, Compare, Allocator>::handle
+MultiQueue<Key, Value, Compare, Allocator>::insert(Value Name, Key key) {
+    // Move on to another shard rather than queue behind a busy lock
+    while (true) {
+        int i = randomShard();
+        Shard &s = *shards[i];
+        if (!s.lock.try_lock())
+            continue;
+        handle x = s.heap.insert(Name, key);
+        x->slot = i;
+        publish(s);
+        s.lock.unlock();
+        return x;
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::decreaseKey(handle x, Key k) {
+    Shard &s = *shards[x->slot];
+    std::lock_guard<std::mutex> guard(s.lock);
+    s.heap.decreaseKey(x, k);
+    publish(s);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::increaseKey(handle x, Key k) {
+    Shard &s = *shards[x->slot];
+    std::lock_guard<std::mutex> guard(s.lock);
+    s.heap.increaseKey(x, k);
+    publish(s);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::erase(handle x) {
+    Shard &s = *shards[x->slot];
+    std::lock_guard<std::mutex> guard(s.lock);
+    s.heap.erase(x);
+    publish(s);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::meld(MultiQueue &&other) {
+    if (&other == this) return;
+
+    for (int j = 0; j < other.shardCount(); j++) {
+        Shard &from = *other.shards[j];
+        int i = j % shardCount();
+        Shard &into = *shards[i];
+        std::lock_guard<std::mutex> guard(into.lock);
+        if (i != j)
+            relabel(from, i);
+        into.heap.meld(std::move(from.heap));
+        publish(into);
+        from.count.store(0, std::memory_order_release);
+    }
+    handler->verbose_log(15, "Meld function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *MultiQueue<Key, Value, Compare, Allocator>::extractMin() {
+    thread_local int extractions = 0;
+    int misses = 0;
+    while (true) {
+        Shard *a = shards[randomShard()].get();
+        Shard *b = shards[randomShard()].get();
+        Shard *s = better(*b, *a) ? b : a;
+        if (s->count.load(std::memory_order_acquire) == 0) {
+            // Both picks were empty; after enough misses make sure the whole queue is
+            if (++misses < shardCount()) continue;
+            if (isEmpty()) {
+                handler->e_log(notFound);
+                return nullptr;
+            }
+            misses = 0;
+            continue;
+        }
+        if (!s->lock.try_lock())
+            continue;
+        if (s->heap.getSize() == 0) {
+            s->lock.unlock();
+            continue;
+        }
+        Node<Value, Key> *x = s->heap.extractMin();
+        publish(*s);
+        s->lock.unlock();
+        if (++extractions % sampleInterval == 0)
+            sampleRankError(x->key);
+        return x;
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+std::vector<typename MultiQueue<Key, Value, Compare, Allocator>::handle>
+MultiQueue<Key, Value, Compare, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    if (k <= 0) return result;
+    // Shards are locked in index order, the same order every caller uses
+    for (auto &s: shards)
+        s->lock.lock();
+    for (auto &s: shards) {
+        std::vector<handle> part = s->heap.topK(k);
+        result.insert(result.end(), part.begin(), part.end());
+    }
+    for (auto &s: shards)
+        s->lock.unlock();
+
+    auto before = [this](handle a, handle b) { return comp(a->key, b->key); };
+    if (static_cast<int>(result.size()) > k) {
+        std::partial_sort(result.begin(), result.begin() + k, result.end(), before);
+        result.resize(k);
+    } else {
+        std::sort(result.begin(), result.end(), before);
+    }
+    return result;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *MultiQueue<Key, Value, Compare, Allocator>::displayMinimum() {
+    std::vector<handle> top = topK(1);
+    return top.empty() ? nullptr : top.front();
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::modifyKey(Key currentNodeKey, Key new_k) {
+    // Shards are locked in index order, the same order every caller uses
+    for (auto &s: shards)
+        s->lock.lock();
+    Shard *owner = nullptr;
+    Node<Value, Key> *x = nullptr;
+    bool taken = false;
+    for (auto &s: shards) {
+        if (x == nullptr && (x = s->heap.find(currentNodeKey)) != nullptr)
+            owner = s.get();
+        if (s->heap.find(new_k) != nullptr)
+            taken = true;
+    }
+    int error = 0;
+    if (x == nullptr)
+        error = notFound;
+    else if (x->key == new_k)
+        error = sameKey;
+    else if (taken)
+        error = keyTaken;
+    else {
+        if (comp(x->key, new_k))
+            owner->heap.increaseKey(x, new_k);
+        else
+            owner->heap.decreaseKey(x, new_k);
+        publish(*owner);
+    }
+    for (auto &s: shards)
+        s->lock.unlock();
+
+    if (error != 0) {
+        handler->e_log(error);
+        return;
+    }
+    handler->verbose_log(15, "ModifyKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::deleteNode(Key key) {
+    for (auto &s: shards) {
+        std::unique_lock<std::mutex> guard(s->lock);
+        Node<Value, Key> *x = s->heap.find(key);
+        if (x == nullptr) continue;
+        s->heap.erase(x);
+        s->heap.destroyNode(x);
+        publish(*s);
+        guard.unlock();
+        handler->verbose_log(15, "DeleteNode Function called.");
+        return;
+    }
+    handler->e_log(notFound);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void MultiQueue<Key, Value, Compare, Allocator>::display() {
+    handler->verbose_log(15, "Display Function called.");
+    if (isEmpty()) {
+        handler->e_log(emptyHeap);
+        return;
+    }
+    for (int i = 0; i < shardCount(); i++) {
+        Shard &s = *shards[i];
+        std::lock_guard<std::mutex> guard(s.lock);
+        if (s.heap.getSize() == 0) continue;
+        std::cout << "Shard " << i << ":" << std::endl;
+        s.heap.display();
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *MultiQueue<Key, Value, Compare, Allocator>::find(Key key) const {
+    for (auto &s: shards) {
+        std::lock_guard<std::mutex> guard(s->lock);
+        if (Node<Value, Key> *x = s->heap.find(key))
+            return x;
+    }
+    return nullptr;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+bool MultiQueue<Key, Value, Compare, Allocator>::isEmpty() {
+    for (auto &s: shards) {
+        if (s->count.load(std::memory_order_acquire) > 0)
+            return false;
+    }
+    return true;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int MultiQueue<Key, Value, Compare, Allocator>::getSize() {
+    int size = 0;
+    for (auto &s: shards)
+        size += s->count.load(std::memory_order_acquire);
+    return size;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+double MultiQueue<Key, Value, Compare, Allocator>::meanRankError() const {
+    long long n = samples.load(std::memory_order_relaxed);
+    return n == 0 ? 0.0 : static_cast<double>(rankErrorSum.load(std::memory_order_relaxed)) / n;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int MultiQueue<Key, Value, Compare, Allocator>::maxRankError() const {
+    return rankErrorMax.load(std::memory_order_relaxed);
+}
+
+#endif // MULTIQUEUE_H
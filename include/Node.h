@@ -6,15 +6,92 @@
  * @brief Forward declaration of FibHeap class template.
  * @tparam T The type of data stored in the node.
  */
-template<typename T>
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
 class FibHeap;
 
+/**
+ * @class PairingHeap
+ * @brief Forward declaration of PairingHeap class template.
+ */
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+class PairingHeap;
+
+/**
+ * @class RadixHeap
+ * @brief Forward declaration of RadixHeap class template.
+ */
+template<typename Key, typename Value, template<typename> class Allocator>
+class RadixHeap;
+
+/**
+ * @class HollowHeap
+ * @brief Forward declaration of HollowHeap class template.
+ */
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+class HollowHeap;
+
+/**
+ * @class RankPairingHeap
+ * @brief Forward declaration of RankPairingHeap class template.
+ */
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+class RankPairingHeap;
+
+/**
+ * @class BinomialHeap
+ * @brief Forward declaration of BinomialHeap class template.
+ */
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+class BinomialHeap;
+
+/**
+ * @class BucketQueue
+ * @brief Forward declaration of BucketQueue class template.
+ */
+template<typename Key, typename Value, int Range, template<typename> class Allocator>
+class BucketQueue;
+
+/**
+ * @class CalendarQueue
+ * @brief Forward declaration of CalendarQueue class template.
+ */
+template<typename Key, typename Value, template<typename> class Allocator>
+class CalendarQueue;
+
+/**
+ * @class SoftHeap
+ * @brief Forward declaration of SoftHeap class template.
+ */
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+class SoftHeap;
+
+/**
+ * @class MultiQueue
+ * @brief Forward declaration of MultiQueue class template.
+ */
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+class MultiQueue;
+
+/**
+ * @class DaryHeap
+ * @brief Forward declaration of DaryHeap class template.
+ */
+template<typename Key, typename Value, int D, typename Compare, template<typename> class Allocator>
+class DaryHeap;
+
+/**
+ * @class KeyIndex
+ * @brief Forward declaration of KeyIndex class template.
+ */
+template<typename Key, typename Value>
+class KeyIndex;
+
 /**
  * @class DoublyCircularLinkedList
  * @brief Forward declaration of DoublyCircularLinkedList class template.
  * @tparam T The type of data stored in the node.
  */
-template<typename T>
+template<typename T, typename K>
 class DoublyCircularLinkedList;
 
 /**
@@ -35,19 +112,23 @@ class VisualizeTaskManager;
  * @class Node
  * @brief Represents a node in a doubly linked list.
  * @tparam T The type of data stored in the node.
+ * @tparam K The type of the node's key.
  */
-template<typename T>
+template<typename T, typename K = int>
 class Node {
 private:
-    int key; ///< The key value of the node.
+    K key; ///< The key value of the node.
     T Name; ///< The name associated with the node.
     int deg; ///< The degree of the node (number of children).
     Node *parent; ///< Pointer to the parent node.
-    DoublyCircularLinkedList<T> *child; ///< Pointer to DLL of the children of that specific node.
+    Node *child; ///< Pointer to one of the node's children; the children are linked through their left/right pointers.
     Node *left; ///< Pointer to the left sibling node.
     Node *right; ///< Pointer to the right sibling node.
     bool mark; ///< Mark indicating whether the node has lost a child since it became a child of its current parent.
+    bool deleted = false; ///< Tombstone set by FibHeap's lazy delete; the node stays in the forest until consolidation drops it.
     Patient * data = nullptr; ///< Class upholding Patient's extra data, Managed by the Hospital Task Manager
+    int slot = 0; ///< Position of the node inside an array-based engine's storage; unused by the tree engines.
+    Node *indexNext = nullptr; ///< Next node in the same KeyIndex chain.
 
 public:
     /**
@@ -55,18 +136,18 @@ public:
      * @param Name The name to be assigned to the node.
      * @param key The key value to be assigned to the node.
      */
-    Node(T Name, int key);
+    Node(T Name, K key);
 
     /**
      * @brief Default destructor.
      */
-    ~Node();
+    ~Node() = default;
 
     /**
      * @brief Gets the key value of the node.
      * @return The key value of the node.
      */
-    int getKey() const;
+    K getKey() const;
 
     /**
      * @brief Gets the name of the node.
@@ -85,45 +166,65 @@ public:
     Patient *getData();
 
     // Friend class declarations
-    friend class DoublyCircularLinkedList<T>;
+    friend class DoublyCircularLinkedList<T, K>;
     friend class VisualizeFibonacciHeap;
-    friend class FibHeap<T>;
+    template<typename, typename, typename, template<typename> class>
+    friend class FibHeap;
+    template<typename, typename, typename, template<typename> class>
+    friend class PairingHeap;
+    template<typename, typename, template<typename> class>
+    friend class RadixHeap;
+    template<typename, typename, int, typename, template<typename> class>
+    friend class DaryHeap;
+    template<typename, typename, typename, template<typename> class>
+    friend class HollowHeap;
+    template<typename, typename, typename, template<typename> class>
+    friend class RankPairingHeap;
+    template<typename, typename, typename, template<typename> class>
+    friend class BinomialHeap;
+    template<typename, typename, int, template<typename> class>
+    friend class BucketQueue;
+    template<typename, typename, template<typename> class>
+    friend class CalendarQueue;
+    template<typename, typename, typename, template<typename> class>
+    friend class SoftHeap;
+    template<typename, typename, typename, template<typename> class>
+    friend class MultiQueue;
+    template<typename, typename>
+    friend class KeyIndex;
     friend class VisualizeTaskManager;
 };
 
-template<typename T>
-Node<T>::Node(T Name, int key) : key(key), Name(Name), deg(0), parent(nullptr), child(nullptr),
+template<typename T, typename K>
+Node<T, K>::Node(T Name, K key) : key(key), Name(Name), deg(0), parent(nullptr), child(nullptr),
                                  left(this), right(this), mark(false) {
 }
 
-template<typename T>
-void Node<T>::setData(Patient * data) {
+template<typename T, typename K>
+void Node<T, K>::setData(Patient * data) {
  this->data = data;
 }
-template<typename T>
-void Node<T>::setName(T Name) {
+template<typename T, typename K>
+void Node<T, K>::setName(T Name) {
  this->Name = Name;
 }
-template<typename T>
-Patient* Node<T>::getData() {
+template<typename T, typename K>
+Patient* Node<T, K>::getData() {
  return this->data;
 }
 
 
-template<typename T>
-Node<T>::~Node() = default;
-
-template<typename T>
-int Node<T>::getKey() const {
+template<typename T, typename K>
+K Node<T, K>::getKey() const {
     return key;
 }
 
-template<typename T>
-int Node<T>::getDeg() const {
+template<typename T, typename K>
+int Node<T, K>::getDeg() const {
     return deg;
 }
 
-template<typename T>
-T Node<T>::getName() const {
+template<typename T, typename K>
+T Node<T, K>::getName() const {
     return Name;
 }
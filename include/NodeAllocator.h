@@ -0,0 +1,248 @@
+#ifndef NODEALLOCATOR_H
+#define NODEALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @class NodePool
+ * @brief Slab allocator that recycles node storage through a free list.
+ *
+ * Nodes are carved out of fixed-size slabs. A deallocated node goes back on the
+ * free list and is handed out again by the next allocation, so a heap whose size
+ * has stopped growing gets its nodes without calling into malloc. KeyIndex chains
+ * through the nodes themselves, so the key index does not allocate per insert
+ * either.
+ *
+ * @tparam NodeT The node type being allocated.
+ */
+template<typename NodeT>
+class NodePool {
+private:
+    /**
+     * @brief Storage for one node, reused as a free-list link while the node is dead.
+     */
+    union Slot {
+        Slot *next;
+        alignas(NodeT) unsigned char storage[sizeof(NodeT)];
+    };
+
+    static const int slabNodes = 256; ///< Number of nodes carved out of each slab.
+
+    std::vector<std::unique_ptr<Slot[]> > slabs; ///< Every slab owned by the pool.
+    Slot *freeList = nullptr; ///< Released slots waiting to be reused.
+    Slot *freeTail = nullptr; ///< Last slot of the free list, kept so merge() can splice in O(1).
+    Slot *cursor = nullptr; ///< Next never-used slot of the newest slab.
+    int remaining = 0; ///< Number of never-used slots left in the newest slab.
+
+public:
+    static constexpr bool bulk_release = false; ///< Releasing the pool does not destroy live nodes.
+    static constexpr bool thread_safe = false; ///< The free list is not guarded, so one thread at a time.
+
+    NodePool() = default;
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    /**
+     * @brief Constructs a node in recycled storage, or in a fresh slab slot if none is free.
+     *
+     * @param args Arguments forwarded to the node constructor.
+     * @return NodeT* The constructed node.
+     */
+    template<typename... Args>
+    NodeT *allocate(Args &&... args) {
+        Slot *slot = freeList;
+        if (slot != nullptr) {
+            freeList = slot->next;
+            if (freeList == nullptr)
+                freeTail = nullptr;
+        } else {
+            if (remaining == 0) {
+                slabs.emplace_back(new Slot[slabNodes]);
+                cursor = slabs.back().get();
+                remaining = slabNodes;
+            }
+            slot = cursor++;
+            --remaining;
+        }
+        return new(slot->storage) NodeT(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys a node and puts its storage on the free list.
+     *
+     * @param x The node to release. Null is ignored.
+     */
+    void deallocate(NodeT *x) {
+        if (x == nullptr) return;
+        x->~NodeT();
+        Slot *slot = reinterpret_cast<Slot *>(x);
+        slot->next = freeList;
+        if (freeList == nullptr)
+            freeTail = slot;
+        freeList = slot;
+    }
+
+    /**
+     * @brief Takes over every slab and free slot of another pool.
+     *
+     * Nodes allocated by other stay where they are and can afterwards be released
+     * through this pool. The smaller slab list is appended to the larger one.
+     *
+     * @param other The pool to empty into this one.
+     */
+    void merge(NodePool &other) {
+        if (slabs.size() < other.slabs.size())
+            slabs.swap(other.slabs);
+        for (auto &slab: other.slabs)
+            slabs.push_back(std::move(slab));
+        other.slabs.clear();
+        if (other.freeList != nullptr) {
+            other.freeTail->next = freeList;
+            if (freeList == nullptr)
+                freeTail = other.freeTail;
+            freeList = other.freeList;
+        }
+        other.freeList = other.freeTail = nullptr;
+        other.cursor = nullptr;
+        other.remaining = 0;
+    }
+};
+
+/**
+ * @class NodeArena
+ * @brief Bump allocator that frees all of its nodes at once.
+ *
+ * Allocation only advances a pointer through geometrically growing blocks, and
+ * individual deallocation never returns memory. release() drops every block in
+ * one go, which lets a heap of trivially destructible nodes be cleared without
+ * visiting them.
+ *
+ * @tparam NodeT The node type being allocated.
+ */
+template<typename NodeT>
+class NodeArena {
+private:
+    /**
+     * @brief Uninitialized storage for one node.
+     */
+    struct Slot {
+        alignas(NodeT) unsigned char storage[sizeof(NodeT)];
+    };
+
+    static const int firstBlockNodes = 256; ///< Capacity of the first block; each later block doubles it.
+
+    std::vector<std::unique_ptr<Slot[]> > blocks; ///< Every block owned by the arena.
+    Slot *cursor = nullptr; ///< Next unused slot of the newest block.
+    std::size_t remaining = 0; ///< Number of unused slots left in the newest block.
+    std::size_t nextBlockNodes = firstBlockNodes; ///< Capacity of the next block to allocate.
+
+public:
+    static constexpr bool bulk_release = true; ///< release() frees every node without visiting it.
+    static constexpr bool thread_safe = false; ///< The bump pointer is not guarded, so one thread at a time.
+
+    NodeArena() = default;
+    NodeArena(const NodeArena &) = delete;
+    NodeArena &operator=(const NodeArena &) = delete;
+
+    /**
+     * @brief Constructs a node in the next free slot of the arena.
+     *
+     * @param args Arguments forwarded to the node constructor.
+     * @return NodeT* The constructed node.
+     */
+    template<typename... Args>
+    NodeT *allocate(Args &&... args) {
+        if (remaining == 0) {
+            blocks.emplace_back(new Slot[nextBlockNodes]);
+            cursor = blocks.back().get();
+            remaining = nextBlockNodes;
+            nextBlockNodes *= 2;
+        }
+        --remaining;
+        return new(cursor++->storage) NodeT(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys a node. Its storage is only reclaimed by release().
+     *
+     * @param x The node to destroy. Null is ignored.
+     */
+    void deallocate(NodeT *x) {
+        if (x != nullptr)
+            x->~NodeT();
+    }
+
+    /**
+     * @brief Takes over every block of another arena.
+     *
+     * Nodes allocated by other stay where they are and are freed by this arena's
+     * release(). The smaller block list is appended to the larger one.
+     *
+     * @param other The arena to empty into this one.
+     */
+    void merge(NodeArena &other) {
+        if (blocks.size() < other.blocks.size())
+            blocks.swap(other.blocks);
+        for (auto &block: other.blocks)
+            blocks.push_back(std::move(block));
+        other.blocks.clear();
+        other.cursor = nullptr;
+        other.remaining = 0;
+        other.nextBlockNodes = firstBlockNodes;
+    }
+
+    /**
+     * @brief Frees every block at once without running node destructors.
+     */
+    void release() {
+        blocks.clear();
+        cursor = nullptr;
+        remaining = 0;
+        nextBlockNodes = firstBlockNodes;
+    }
+};
+
+/**
+ * @class NodeNewDelete
+ * @brief Allocator that sends every node straight to operator new and delete.
+ *
+ * @tparam NodeT The node type being allocated.
+ */
+template<typename NodeT>
+class NodeNewDelete {
+public:
+    static constexpr bool bulk_release = false; ///< Nodes are always freed one by one.
+    static constexpr bool thread_safe = true; ///< Stateless, so any thread may allocate and free.
+
+    /**
+     * @brief Allocates and constructs a node with operator new.
+     *
+     * @param args Arguments forwarded to the node constructor.
+     * @return NodeT* The constructed node.
+     */
+    template<typename... Args>
+    NodeT *allocate(Args &&... args) {
+        return new NodeT(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys and frees a node with operator delete.
+     *
+     * @param x The node to free. Null is ignored.
+     */
+    void deallocate(NodeT *x) {
+        delete x;
+    }
+
+    /**
+     * @brief Nothing to take over, since nodes are not tied to an allocator instance.
+     */
+    void merge(NodeNewDelete &) {
+    }
+};
+
+#endif // NODEALLOCATOR_H
@@ -0,0 +1,507 @@
+#ifndef PAIRINGHEAP_H
+#define PAIRINGHEAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
+#include "error_handler.h"
+
+/**
+ * @class PairingHeap
+ * @brief Represents a pairing heap with the same interface as FibHeap.
+ *
+ * A single heap-ordered tree. Each node keeps its leftmost child in child, its
+ * siblings in left/right (left is null for a first child) and its parent in
+ * parent. Insert, meld and decrease-key are a single comparison-and-link;
+ * extractMin restructures the root's children with the two-pass pairing rule.
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Compare Strict weak ordering on keys; the node that compares first is the minimum.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key>,
+    template<typename> class Allocator = NodePool>
+class PairingHeap : public KeyedHeap<PairingHeap<Key, Value, Compare, Allocator>, Key, Value, 5, Compare> {
+private:
+    using Keyed = KeyedHeap<PairingHeap, Key, Value, 5, Compare>;
+    friend Keyed;
+
+    Node<Value, Key> *root; ///< Root of the tree, which holds the minimum key.
+    int size; ///< Number of nodes in the heap.
+    KeyIndex<Key, Value> index; ///< Key to node index backing find().
+    error_handler *handler;
+    Compare comp; ///< Key ordering; comp(a, b) means a belongs above b.
+    Allocator<Node<Value, Key> > allocator; ///< Storage for every node created through this heap.
+    std::vector<Node<Value, Key> *> pairs; ///< Scratch list reused by mergePairs().
+
+    /**
+     * @brief Links two isolated trees, making the larger root the first child of the smaller.
+     *
+     * @param a The first tree, may be null.
+     * @param b The second tree, may be null.
+     * @return Node<Value, Key>* The root of the linked tree.
+     */
+    Node<Value, Key> *join(Node<Value, Key> *a, Node<Value, Key> *b);
+
+    /**
+     * @brief Combines a sibling list into one tree with the two-pass pairing rule.
+     *
+     * @param first The first node of the sibling list, may be null.
+     * @return Node<Value, Key>* The root of the combined tree.
+     */
+    Node<Value, Key> *mergePairs(Node<Value, Key> *first);
+
+    /**
+     * @brief Unlinks a non-root node, together with its subtree, from its parent.
+     *
+     * @param x The node to unlink.
+     */
+    void detach(Node<Value, Key> *x);
+
+    /**
+     * @brief Takes a node out of the tree, promoting its children in its place.
+     *
+     * @param x The node to take out. Its key entry is left in the index.
+     */
+    void remove(Node<Value, Key> *x);
+
+public:
+    /**
+     * @brief Stable reference to a node in the heap.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
+    /**
+     * @brief Constructs a new, empty pairing heap.
+     */
+    PairingHeap(error_handler *handler);
+
+    /**
+     * @brief Destroys the heap and releases every node still in it.
+     */
+    ~PairingHeap();
+
+    PairingHeap(const PairingHeap &) = delete;
+    PairingHeap &operator=(const PairingHeap &) = delete;
+
+    /**
+     * @brief Allocates a node from the heap's allocator without inserting it.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The new node.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the heap to the allocator.
+     *
+     * @param x The node to release. Null is ignored.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the heap.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the heap.
+     *
+     * @param x The node to be inserted.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the heap.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Inserts a batch of nodes that are in no heap in linear time.
+     *
+     * The nodes' links are reset, they are chained as siblings and combined into
+     * one tree with a single pairing pass, which is then linked to the root.
+     * Meant for nodes handed over by another heap's detachAll().
+     *
+     * @param first Iterator to the first node to insert.
+     * @param last Iterator past the last node to insert.
+     */
+    template<typename InputIt>
+    void insertNodes(InputIt first, InputIt last);
+
+    /**
+     * @brief Empties the heap without freeing its nodes, walking the tree once.
+     *
+     * @param out Receives every node of the heap, now owned by the caller. Their links are left as they were.
+     */
+    void detachAll(std::vector<handle> &out);
+
+    /**
+     * @brief Lowers the key of a node and links it to the root if it now beats its parent.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be greater than the current one.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node by pairing its children in its place and re-linking it.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be less than the current one.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the heap without searching for it.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another heap into this one by linking the two roots.
+     *
+     * @param other The heap to meld into this one. It is left empty.
+     */
+    void meld(PairingHeap &&other);
+
+    /**
+     * @brief Extracts the minimum node from the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the heap.
+     *
+     * @param k The number of nodes to list.
+     * @return std::vector<handle> Up to k nodes in increasing key order.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the minimum node in the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Displays the structure of the heap.
+     */
+    void display();
+
+    /**
+     * @brief Checks if the heap is empty.
+     *
+     * @return true If the heap is empty.
+     * @return false If the heap is not empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the heap.
+     *
+     * @return int The number of nodes in the heap.
+     */
+    int getSize();
+};
+
+// Implementation of the PairingHeap template class
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+PairingHeap<Key, Value, Compare, Allocator>::PairingHeap(error_handler *handler)
+    : root(nullptr), size(0), handler(handler) {}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+PairingHeap<Key, Value, Compare, Allocator>::~PairingHeap() {
+    clear();
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename PairingHeap<Key, Value, Compare, Allocator>::handle
+PairingHeap<Key, Value, Compare, Allocator>::createNode(Value Name, Key key) {
+    return allocator.allocate(Name, key);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void PairingHeap<Key, Value, Compare, Allocator>::destroyNode(handle x) {
+    allocator.deallocate(x);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void PairingHeap<Key, Value, Compare, Allocator>::clear() {
+    if constexpr (Allocator<Node<Value, Key> >::bulk_release && std::is_trivially_destructible<Node<Value, Key> >::value) {
+        allocator.release();
+    } else if (root != nullptr) {
+        std::vector<Node<Value, Key> *> pending(1, root);
+        while (!pending.empty()) {
+            Node<Value, Key> *x = pending.back();
+            pending.pop_back();
+            for (Node<Value, Key> *child = x->child; child != nullptr; child = child->right)
+                pending.push_back(child);
+            allocator.deallocate(x);
+        }
+    }
+    root = nullptr;
+    index.clear();
+    size = 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *PairingHeap<Key, Value, Compare, Allocator>::join(Node<Value, Key> *a, Node<Value, Key> *b) {
+    if (a == nullptr) return b;
+    if (b == nullptr) return a;
+    if (comp(b->key, a->key))
+        std::swap(a, b);
+    b->parent = a;
+    b->left = nullptr;
+    b->right = a->child;
+    if (a->child != nullptr)
+        a->child->left = b;
+    a->child = b;
+    return a;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *PairingHeap<Key, Value, Compare, Allocator>::mergePairs(Node<Value, Key> *first) {
+    if (first == nullptr) return nullptr;
+
+    // First pass: link siblings pairwise from left to right
+    pairs.clear();
+    Node<Value, Key> *a = first;
+    while (a != nullptr) {
+        Node<Value, Key> *b = a->right;
+        Node<Value, Key> *next = b != nullptr ? b->right : nullptr;
+        a->left = a->right = a->parent = nullptr;
+        if (b != nullptr) {
+            b->left = b->right = b->parent = nullptr;
+            a = join(a, b);
+        }
+        pairs.push_back(a);
+        a = next;
+    }
+
+    // Second pass: fold the pairs from right to left
+    Node<Value, Key> *result = pairs.back();
+    for (std::size_t i = pairs.size() - 1; i-- > 0;)
+        result = join(pairs[i], result);
+    return result;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void PairingHeap<Key, Value, Compare, Allocator>::detach(Node<Value, Key> *x) {
+    if (x->left == nullptr)
+        x->parent->child = x->right;
+    else
+        x->left->right = x->right;
+    if (x->right != nullptr)
+        x->right->left = x->left;
+    x->left = x->right = x->parent = nullptr;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void PairingHeap<Key, Value, Compare, Allocator>::remove(Node<Value, Key> *x) {
+    Node<Value, Key> *children = x->child;
+    x->child = nullptr;
+    if (x == root) {
+        root = mergePairs(children);
+    } else {
+        detach(x);
+        root = join(root, mergePairs(children));
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename PairingHeap<Key, Value, Compare, Allocator>::handle
+PairingHeap<Key, Value, Compare, Allocator>::insert(Node<Value, Key> *x) {
+    x->deg = 0;
+    x->parent = x->child = x->left = x->right = nullptr;
+    x->mark = false;
+    index.insert(x);
+    root = join(root, x);
+    ++size;
+    handler->verbose_log(5, "Insert function called.");
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename PairingHeap<Key, Value, Compare, Allocator>::handle
+PairingHeap<Key, Value, Compare, Allocator>::insert(Value Name, Key key) {
+    return insert(createNode(Name, key));
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+template<typename InputIt>
+void PairingHeap<Key, Value, Compare, Allocator>::insertNodes(InputIt first, InputIt last) {
+    Node<Value, Key> *siblings = nullptr;
+    for (; first != last; ++first) {
+        Node<Value, Key> *x = *first;
+        x->deg = 0;
+        x->parent = x->child = x->left = nullptr;
+        x->mark = false;
+        x->right = siblings;
+        siblings = x;
+        index.insert(x);
+        ++size;
+    }
+    root = join(root, mergePairs(siblings));
+    handler->verbose_log(5, "InsertNodes function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void PairingHeap<Key, Value, Compare, Allocator>::detachAll(std::vector<handle> &out) {
+    if (root != nullptr) {
+        std::size_t next = out.size();
+        out.push_back(root);
+        // Breadth-first over the tree, using out itself as the queue
+        while (next < out.size()) {
+            for (Node<Value, Key> *child = out[next++]->child; child != nullptr; child = child->right)
+                out.push_back(child);
+        }
+    }
+    root = nullptr;
+    index.clear();
+    size = 0;
+    handler->verbose_log(5, "DetachAll function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void PairingHeap<Key, Value, Compare, Allocator>::decreaseKey(handle x, Key k) {
+    if (comp(x->key, k)) {
+        handler->e_log(5, "New key is greater than the current key.\n");
+        return;
+    }
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    if (x != root && comp(x->key, x->parent->key)) {
+        detach(x);
+        root = join(root, x);
+    }
+    handler->verbose_log(5, "DecreaseKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void PairingHeap<Key, Value, Compare, Allocator>::increaseKey(handle x, Key k) {
+    if (comp(k, x->key)) {
+        handler->e_log(5, "New key is less than the current key.\n");
+        return;
+    }
+    remove(x);
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    root = join(root, x);
+    handler->verbose_log(5, "IncreaseKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void PairingHeap<Key, Value, Compare, Allocator>::erase(handle x) {
+    remove(x);
+    index.erase(x);
+    --size;
+    handler->verbose_log(5, "Erase function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void PairingHeap<Key, Value, Compare, Allocator>::meld(PairingHeap &&other) {
+    if (&other == this) return;
+
+    root = join(root, other.root);
+    size += other.size;
+    index.merge(other.index);
+    allocator.merge(other.allocator);
+    other.root = nullptr;
+    other.size = 0;
+    handler->verbose_log(5, "Meld function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *PairingHeap<Key, Value, Compare, Allocator>::extractMin() {
+    Node<Value, Key> *minptr = root;
+    if (minptr == nullptr) {
+        handler->e_log(Keyed::notFound);
+        return nullptr;
+    }
+    erase(minptr);
+    handler->verbose_log(5, "ExtractMin function called.");
+    return minptr;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+std::vector<typename PairingHeap<Key, Value, Compare, Allocator>::handle>
+PairingHeap<Key, Value, Compare, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    if (root == nullptr || k <= 0) return result;
+    auto later = [this](Node<Value, Key> *a, Node<Value, Key> *b) { return comp(b->key, a->key); };
+
+    std::vector<Node<Value, Key> *> candidates(1, root);
+    result.reserve(std::min<std::size_t>(k, size));
+    while (static_cast<int>(result.size()) < k && !candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), later);
+        Node<Value, Key> *x = candidates.back();
+        candidates.pop_back();
+        result.push_back(x);
+
+        for (Node<Value, Key> *child = x->child; child != nullptr; child = child->right) {
+            candidates.push_back(child);
+            std::push_heap(candidates.begin(), candidates.end(), later);
+        }
+    }
+    return result;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *PairingHeap<Key, Value, Compare, Allocator>::displayMinimum() {
+    return root;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void PairingHeap<Key, Value, Compare, Allocator>::display() {
+    handler->verbose_log(5, "Display Function called.");
+    if (!root) {
+        handler->e_log(Keyed::emptyHeap);
+        return;
+    }
+
+    std::function<void(Node<Value, Key>*, int)> displayNode = [&](Node<Value, Key>* node, int level) {
+        for (; node != nullptr; node = node->right) {
+            for (int i = 0; i < level; ++i) std::cout << "  ";
+            std::cout << "Key: " << node->getKey() << ", Name: " << node->getName() << std::endl;
+            displayNode(node->child, level + 1);
+        }
+    };
+
+    displayNode(root, 0);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+bool PairingHeap<Key, Value, Compare, Allocator>::isEmpty() {
+    return size == 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int PairingHeap<Key, Value, Compare, Allocator>::getSize() {
+    return size;
+}
+
+#endif // PAIRINGHEAP_H
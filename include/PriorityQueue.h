@@ -0,0 +1,361 @@
+#ifndef PRIORITYQUEUE_H
+#define PRIORITYQUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "KeyHash.h"
+#include "Node.h"
+#include "error_handler.h"
+
+/**
+ * @brief Compile-time check for the priority-queue interface shared by the heap engines.
+ *
+ * HospitalTaskManager and VisualizeTaskManager take their heap as a template
+ * parameter, so any engine that provides this interface can be swapped in
+ * without touching them. An engine exposes key_type, value_type and a handle
+ * type (a pointer to its Node), and provides:
+ *
+ * - handle insert(value_type Name, key_type key)
+ * - handle extractMin() and handle displayMinimum()
+ * - void decreaseKey(handle, key_type), increaseKey(handle, key_type) and erase(handle)
+ * - void modifyKey(key_type, key_type) and deleteNode(key_type)
+ * - handle find(key_type) const
+ * - void meld(Engine &&)
+ * - std::vector<handle> topK(int) const
+ * - void destroyNode(handle), bool isEmpty(), int getSize() and void display()
+ *
+ * @tparam Engine The heap type to check.
+ */
+template<typename Engine, typename = void>
+struct IsPriorityQueue : std::false_type {
+};
+
+template<typename Engine>
+struct IsPriorityQueue<Engine, std::void_t<
+    typename Engine::handle,
+    typename Engine::key_type,
+    typename Engine::value_type,
+    decltype(std::declval<Engine &>().insert(std::declval<typename Engine::value_type>(),
+                                             std::declval<typename Engine::key_type>())),
+    decltype(std::declval<Engine &>().extractMin()),
+    decltype(std::declval<Engine &>().displayMinimum()),
+    decltype(std::declval<Engine &>().decreaseKey(std::declval<typename Engine::handle>(),
+                                                  std::declval<typename Engine::key_type>())),
+    decltype(std::declval<Engine &>().increaseKey(std::declval<typename Engine::handle>(),
+                                                  std::declval<typename Engine::key_type>())),
+    decltype(std::declval<Engine &>().erase(std::declval<typename Engine::handle>())),
+    decltype(std::declval<Engine &>().modifyKey(std::declval<typename Engine::key_type>(),
+                                                std::declval<typename Engine::key_type>())),
+    decltype(std::declval<Engine &>().deleteNode(std::declval<typename Engine::key_type>())),
+    decltype(std::declval<const Engine &>().find(std::declval<typename Engine::key_type>())),
+    decltype(std::declval<Engine &>().meld(std::declval<Engine &&>())),
+    decltype(std::declval<const Engine &>().topK(0)),
+    decltype(std::declval<Engine &>().destroyNode(std::declval<typename Engine::handle>())),
+    decltype(std::declval<Engine &>().isEmpty()),
+    decltype(std::declval<Engine &>().getSize()),
+    decltype(std::declval<Engine &>().display())
+> > : std::is_same<decltype(std::declval<Engine &>().extractMin()), typename Engine::handle> {
+};
+
+/**
+ * @brief Compile-time check for engines that can pre-size their storage with reserve(int).
+ *
+ * @tparam Engine The heap type to check.
+ */
+template<typename Engine, typename = void>
+struct HasReserve : std::false_type {
+};
+
+template<typename Engine>
+struct HasReserve<Engine, std::void_t<decltype(std::declval<Engine &>().reserve(0))> > : std::true_type {
+};
+
+/**
+ * @brief Compile-time check for engines that can insert a batch of (name, key) pairs with insertRange().
+ *
+ * @tparam Engine The heap type to check.
+ */
+template<typename Engine, typename = void>
+struct HasInsertRange : std::false_type {
+};
+
+template<typename Engine>
+struct HasInsertRange<Engine, std::void_t<decltype(std::declval<Engine &>().insertRange(
+    std::declval<std::pair<typename Engine::value_type, typename Engine::key_type> *>(),
+    std::declval<std::pair<typename Engine::value_type, typename Engine::key_type> *>()))> > : std::true_type {
+};
+
+/**
+ * @class KeyIndex
+ * @brief Key to node index that backs find() in the heap engines.
+ *
+ * Keys may repeat, in which case find() returns any node holding the key. An
+ * engine adds a node when it enters the heap, drops it when it leaves, and
+ * drops and re-adds it around a key change.
+ *
+ * The index is a chained hash table whose chains run through the nodes
+ * themselves (Node::indexNext), so adding and dropping a node never allocates.
+ * Only growing the bucket array does, which stops once the heap stops growing
+ * or after reserve().
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ */
+template<typename Key, typename Value>
+class KeyIndex {
+private:
+    static constexpr std::size_t minBuckets = 16; ///< Bucket count of the first table.
+
+    std::vector<Node<Value, Key> *> buckets; ///< Head of each chain; empty or a power of two long.
+    std::size_t count = 0; ///< Number of nodes in the index.
+
+    /**
+     * @brief Gets the chain a key belongs to. The table must not be empty.
+     */
+    Node<Value, Key> *&chain(const Key &key) {
+        return buckets[KeyHash<Key>()(key) & (buckets.size() - 1)];
+    }
+
+    /**
+     * @brief Pushes a node onto the front of its key's chain.
+     */
+    void link(Node<Value, Key> *x) {
+        Node<Value, Key> *&head = chain(x->key);
+        x->indexNext = head;
+        head = x;
+    }
+
+    /**
+     * @brief Grows the bucket array to at least n buckets and moves every node to its new chain.
+     */
+    void rehash(std::size_t n);
+
+public:
+    /**
+     * @brief Adds a node under its current key.
+     */
+    void insert(Node<Value, Key> *x) {
+        if (count >= buckets.size())
+            rehash(buckets.empty() ? minBuckets : 2 * buckets.size());
+        link(x);
+        ++count;
+    }
+
+    /**
+     * @brief Drops a node, which must still hold the key it was added under. Does nothing if it is not in the index.
+     */
+    void erase(Node<Value, Key> *x) {
+        if (buckets.empty())
+            return;
+        for (Node<Value, Key> **p = &chain(x->key); *p != nullptr; p = &(*p)->indexNext) {
+            if (*p == x) {
+                *p = x->indexNext;
+                x->indexNext = nullptr;
+                --count;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Finds a node with the given key.
+     *
+     * @return Node<Value, Key>* A node holding key, or nullptr if there is none.
+     */
+    Node<Value, Key> *find(const Key &key) const {
+        if (buckets.empty())
+            return nullptr;
+        for (Node<Value, Key> *x = buckets[KeyHash<Key>()(key) & (buckets.size() - 1)]; x != nullptr; x = x->indexNext) {
+            if (x->key == key)
+                return x;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Moves every node of another index into this one, moving the smaller index into the larger.
+     *
+     * @param other The index to take the nodes from. It is left empty.
+     */
+    void merge(KeyIndex &other);
+
+    /**
+     * @brief Sizes the index for a number of nodes so adding them does not grow the bucket array.
+     */
+    void reserve(std::size_t n) {
+        if (n > buckets.size())
+            rehash(n);
+    }
+
+    /**
+     * @brief Drops every node, keeping the bucket array.
+     */
+    void clear() {
+        std::fill(buckets.begin(), buckets.end(), nullptr);
+        count = 0;
+    }
+
+    /**
+     * @brief Gets the number of nodes in the index.
+     */
+    std::size_t size() const {
+        return count;
+    }
+};
+
+// Implementation of the KeyIndex template class
+
+template<typename Key, typename Value>
+void KeyIndex<Key, Value>::rehash(std::size_t n) {
+    std::size_t target = minBuckets;
+    while (target < n)
+        target *= 2;
+    std::vector<Node<Value, Key> *> previous(target, nullptr);
+    buckets.swap(previous);
+    for (Node<Value, Key> *head : previous) {
+        while (head != nullptr) {
+            Node<Value, Key> *next = head->indexNext;
+            link(head);
+            head = next;
+        }
+    }
+}
+
+template<typename Key, typename Value>
+void KeyIndex<Key, Value>::merge(KeyIndex &other) {
+    if (count < other.count) {
+        buckets.swap(other.buckets);
+        std::swap(count, other.count);
+    }
+    if (other.count == 0)
+        return;
+    reserve(count + other.count);
+    for (Node<Value, Key> *&head : other.buckets) {
+        while (head != nullptr) {
+            Node<Value, Key> *next = head->indexNext;
+            link(head);
+            head = next;
+        }
+    }
+    count += other.count;
+    other.count = 0;
+}
+
+/**
+ * @class HeapErrorCodes
+ * @brief Codes of the messages every heap shares, at fixed offsets from its class id in error_handler.
+ *
+ * @tparam ClassId The heap's class id in error_handler.
+ */
+template<int ClassId>
+class HeapErrorCodes {
+protected:
+    static constexpr int sameKey = ClassId * 10 + 5; ///< Error code: the new key equals the current one.
+    static constexpr int keyTaken = ClassId * 10 + 6; ///< Error code: another node already holds the new key.
+    static constexpr int notFound = ClassId * 10 + 7; ///< Error code: no node holds the key, or the heap is empty.
+    static constexpr int emptyHeap = ClassId * 10 + 8; ///< Error code: there is nothing to display.
+};
+
+/**
+ * @class KeyedHeap
+ * @brief The key-based half of the engine interface, written once for every engine.
+ *
+ * find(), modifyKey() and deleteNode() only need a key index and the handle
+ * operations, so an engine derives from KeyedHeap and befriends it instead of
+ * repeating them. The engine provides an index member (a KeyIndex or anything
+ * with the same find()), a handler member, and the public decreaseKey,
+ * increaseKey, erase and destroyNode. An engine with a cheaper lookup can
+ * declare its own find(), which modifyKey() and deleteNode() then use.
+ *
+ * The error codes of the shared messages, from HeapErrorCodes, are exposed for
+ * the engine's own empty-heap and missing-node paths.
+ *
+ * @tparam Engine The engine deriving from this class.
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam ClassId The engine's class id in error_handler.
+ * @tparam Compare The engine's key ordering; modifyKey() uses it to pick increaseKey or decreaseKey.
+ */
+template<typename Engine, typename Key, typename Value, int ClassId, typename Compare = std::less<Key> >
+class KeyedHeap : public HeapErrorCodes<ClassId> {
+protected:
+    using HeapErrorCodes<ClassId>::sameKey;
+    using HeapErrorCodes<ClassId>::keyTaken;
+    using HeapErrorCodes<ClassId>::notFound;
+    using HeapErrorCodes<ClassId>::emptyHeap;
+
+public:
+    /**
+     * @brief Finds a node with a specific key in the heap.
+     *
+     * @param key The key to search for.
+     * @return Node<Value, Key>* A node holding the key, or nullptr if there is none.
+     */
+    Node<Value, Key> *find(Key key) const;
+
+    /**
+     * @brief Modifies the key of a node.
+     *
+     * @param k The current key of the node.
+     * @param new_k The new key, which no other node may hold.
+     */
+    void modifyKey(Key k, Key new_k);
+
+    /**
+     * @brief Deletes a node with a specific key from the heap and frees it.
+     *
+     * @param k The key of the node to delete.
+     */
+    void deleteNode(Key k);
+};
+
+// Implementation of the KeyedHeap template class
+
+template<typename Engine, typename Key, typename Value, int ClassId, typename Compare>
+Node<Value, Key> *KeyedHeap<Engine, Key, Value, ClassId, Compare>::find(Key key) const {
+    const Engine &self = static_cast<const Engine &>(*this);
+    self.handler->verbose_log(ClassId, "Search function Called.");
+    return self.index.find(key);
+}
+
+template<typename Engine, typename Key, typename Value, int ClassId, typename Compare>
+void KeyedHeap<Engine, Key, Value, ClassId, Compare>::modifyKey(Key currentNodeKey, Key new_k) {
+    Engine &self = static_cast<Engine &>(*this);
+    Node<Value, Key> *x = self.find(currentNodeKey);
+    if (x == nullptr) {
+        self.handler->e_log(notFound);
+        return;
+    }
+    if (x->getKey() == new_k) {
+        self.handler->e_log(sameKey);
+        return;
+    }
+    if (self.find(new_k) != nullptr) {
+        self.handler->e_log(keyTaken);
+        return;
+    }
+    if (Compare()(x->getKey(), new_k))
+        self.increaseKey(x, new_k);
+    else
+        self.decreaseKey(x, new_k);
+    self.handler->verbose_log(ClassId, "ModifyKey function called");
+}
+
+template<typename Engine, typename Key, typename Value, int ClassId, typename Compare>
+void KeyedHeap<Engine, Key, Value, ClassId, Compare>::deleteNode(Key key) {
+    Engine &self = static_cast<Engine &>(*this);
+    Node<Value, Key> *x = self.find(key);
+    if (x == nullptr) {
+        self.handler->e_log(notFound);
+        return;
+    }
+    self.erase(x);
+    self.destroyNode(x);
+    self.handler->verbose_log(ClassId, "DeleteNode Function called.");
+}
+
+#endif // PRIORITYQUEUE_H
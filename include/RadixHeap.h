@@ -0,0 +1,458 @@
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "BitOps.h"
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
+#include "error_handler.h"
+
+/**
+ * @class RadixHeap
+ * @brief Represents a radix heap for monotone, non-negative integer keys.
+ *
+ * Keys are kept in flat per-bucket arrays. Bucket 0 holds keys equal to the last
+ * extracted key, and bucket i holds keys whose highest bit differing from it is
+ * bit i - 1. Bucket ranges therefore increase with i. extractMin empties the
+ * first non-empty bucket into lower buckets around its minimum, so each key
+ * moves at most once per bit: O(log C) amortized for a key range of C.
+ *
+ * The heap is monotone. No key may go below the last extracted key, which suits
+ * shortest-path style workloads that pop keys in non-decreasing order. Inserts
+ * and key changes that would break this are rejected.
+ *
+ * @tparam Key An integral key type; negative keys are rejected.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, template<typename> class Allocator = NodePool>
+class RadixHeap : public KeyedHeap<RadixHeap<Key, Value, Allocator>, Key, Value, 6> {
+private:
+    using Keyed = KeyedHeap<RadixHeap, Key, Value, 6>;
+    friend Keyed;
+
+    static_assert(std::is_integral<Key>::value, "RadixHeap needs integral keys");
+    static_assert(std::numeric_limits<typename std::make_unsigned<Key>::type>::digits < 64,
+                  "RadixHeap tracks its buckets in a 64-bit mask");
+
+    /**
+     * @brief A key stored next to its node so bucket scans stay in one array.
+     */
+    struct Entry {
+        Key key;
+        Node<Value, Key> *node;
+    };
+
+    static const int bucketCount = std::numeric_limits<typename std::make_unsigned<Key>::type>::digits + 1;
+
+    std::vector<Entry> buckets[bucketCount]; ///< Entries grouped by highest bit differing from last.
+    unsigned long long nonEmpty; ///< Bit i is set when bucket i has entries.
+    Key last; ///< The last extracted key; every stored key is at least this.
+    int size; ///< Number of nodes in the heap.
+    KeyIndex<Key, Value> index; ///< Key to node index backing find().
+    error_handler *handler;
+    Allocator<Node<Value, Key> > allocator; ///< Storage for every node created through this heap.
+
+    /**
+     * @brief Bucket a key belongs in relative to the last extracted key.
+     */
+    int bucketOf(Key key) const;
+
+    /**
+     * @brief Appends a node to its bucket and records its position in the node.
+     */
+    void push(Node<Value, Key> *x);
+
+    /**
+     * @brief Removes a node from its bucket by moving the bucket's last entry into its place.
+     */
+    void pop(Node<Value, Key> *x);
+
+    /**
+     * @brief Makes bucket 0 non-empty by redistributing the first non-empty bucket.
+     */
+    void settle();
+
+    /**
+     * @brief Checks that a key may enter the heap, logging an error if not.
+     */
+    bool admissible(Key key);
+
+public:
+    /**
+     * @brief Stable reference to a node in the heap.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
+    /**
+     * @brief Constructs a new, empty radix heap.
+     */
+    RadixHeap(error_handler *handler);
+
+    /**
+     * @brief Destroys the heap and releases every node still in it.
+     */
+    ~RadixHeap();
+
+    RadixHeap(const RadixHeap &) = delete;
+    RadixHeap &operator=(const RadixHeap &) = delete;
+
+    /**
+     * @brief Allocates a node from the heap's allocator without inserting it.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the heap to the allocator.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the heap.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the heap.
+     *
+     * @param x The node to be inserted.
+     * @return handle The node, or nullptr if its key is negative or below the last extracted key.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the heap.
+     *
+     * @return handle The new node, or nullptr if the key was rejected.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Lowers the key of a node, as long as it stays at or above the last extracted key.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node by moving it to its new bucket.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the heap without searching for it.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another radix heap into this one.
+     *
+     * Buckets are relative to the last extracted key, so the melded heap takes the
+     * lower of the two and re-buckets the entries: O(n + m) rather than O(1).
+     *
+     * @param other The heap to meld into this one. It is left empty.
+     */
+    void meld(RadixHeap &&other);
+
+    /**
+     * @brief Extracts the minimum node from the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the heap.
+     *
+     * Buckets are visited in increasing order and only the entries of buckets
+     * that reach the top k are sorted.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the minimum node in the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Displays the contents of every bucket.
+     */
+    void display();
+
+    /**
+     * @brief Checks if the heap is empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the heap.
+     */
+    int getSize();
+};
+
+// Implementation of the RadixHeap template class
+
+template<typename Key, typename Value, template<typename> class Allocator>
+RadixHeap<Key, Value, Allocator>::RadixHeap(error_handler *handler)
+    : nonEmpty(0), last(0), size(0), handler(handler) {}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+RadixHeap<Key, Value, Allocator>::~RadixHeap() {
+    clear();
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+typename RadixHeap<Key, Value, Allocator>::handle RadixHeap<Key, Value, Allocator>::createNode(Value Name, Key key) {
+    return allocator.allocate(Name, key);
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void RadixHeap<Key, Value, Allocator>::destroyNode(handle x) {
+    allocator.deallocate(x);
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void RadixHeap<Key, Value, Allocator>::clear() {
+    for (auto &bucket: buckets) {
+        if constexpr (!(Allocator<Node<Value, Key> >::bulk_release &&
+                        std::is_trivially_destructible<Node<Value, Key> >::value)) {
+            for (const Entry &entry: bucket)
+                allocator.deallocate(entry.node);
+        }
+        bucket.clear();
+    }
+    if constexpr (Allocator<Node<Value, Key> >::bulk_release &&
+                  std::is_trivially_destructible<Node<Value, Key> >::value)
+        allocator.release();
+    nonEmpty = 0;
+    last = 0;
+    index.clear();
+    size = 0;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+int RadixHeap<Key, Value, Allocator>::bucketOf(Key key) const {
+    using Bits = typename std::make_unsigned<Key>::type;
+    return bitWidth(static_cast<Bits>(key) ^ static_cast<Bits>(last));
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void RadixHeap<Key, Value, Allocator>::push(Node<Value, Key> *x) {
+    int b = bucketOf(x->key);
+    x->deg = b;
+    x->slot = static_cast<int>(buckets[b].size());
+    buckets[b].push_back({x->key, x});
+    nonEmpty |= 1ULL << b;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void RadixHeap<Key, Value, Allocator>::pop(Node<Value, Key> *x) {
+    std::vector<Entry> &bucket = buckets[x->deg];
+    Entry moved = bucket.back();
+    bucket[x->slot] = moved;
+    moved.node->slot = x->slot;
+    bucket.pop_back();
+    if (bucket.empty())
+        nonEmpty &= ~(1ULL << x->deg);
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void RadixHeap<Key, Value, Allocator>::settle() {
+    if (!buckets[0].empty() || nonEmpty == 0) return;
+
+    int b = lowestSetBit(nonEmpty);
+    std::vector<Entry> moving;
+    moving.swap(buckets[b]);
+    nonEmpty &= ~(1ULL << b);
+
+    Key lowest = moving.front().key;
+    for (const Entry &entry: moving)
+        lowest = std::min(lowest, entry.key);
+    last = lowest;
+    for (const Entry &entry: moving)
+        push(entry.node);
+
+    // Hand the emptied array back so its capacity is reused
+    moving.clear();
+    buckets[b].swap(moving);
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+bool RadixHeap<Key, Value, Allocator>::admissible(Key key) {
+    if constexpr (std::is_signed<Key>::value) {
+        if (key < 0) {
+            handler->e_log(6, "Keys must be non-negative.\n");
+            return false;
+        }
+    }
+    if (key < last) {
+        handler->e_log(6, "Key is below the last extracted key.\n");
+        return false;
+    }
+    return true;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+typename RadixHeap<Key, Value, Allocator>::handle RadixHeap<Key, Value, Allocator>::insert(Node<Value, Key> *x) {
+    if (!admissible(x->key))
+        return nullptr;
+    push(x);
+    index.insert(x);
+    ++size;
+    handler->verbose_log(6, "Insert function called.");
+    return x;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+typename RadixHeap<Key, Value, Allocator>::handle RadixHeap<Key, Value, Allocator>::insert(Value Name, Key key) {
+    if (!admissible(key))
+        return nullptr;
+    return insert(createNode(Name, key));
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void RadixHeap<Key, Value, Allocator>::decreaseKey(handle x, Key k) {
+    if (k > x->key) {
+        handler->e_log(6, "New key is greater than the current key.\n");
+        return;
+    }
+    if (!admissible(k))
+        return;
+    pop(x);
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    push(x);
+    handler->verbose_log(6, "DecreaseKey function called");
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void RadixHeap<Key, Value, Allocator>::increaseKey(handle x, Key k) {
+    if (k < x->key) {
+        handler->e_log(6, "New key is less than the current key.\n");
+        return;
+    }
+    pop(x);
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    push(x);
+    handler->verbose_log(6, "IncreaseKey function called");
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void RadixHeap<Key, Value, Allocator>::erase(handle x) {
+    pop(x);
+    index.erase(x);
+    --size;
+    handler->verbose_log(6, "Erase function called");
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void RadixHeap<Key, Value, Allocator>::meld(RadixHeap &&other) {
+    if (&other == this) return;
+
+    std::vector<Node<Value, Key> *> nodes;
+    nodes.reserve(size + other.size);
+    for (int b = 0; b < bucketCount; b++) {
+        for (const Entry &entry: buckets[b])
+            nodes.push_back(entry.node);
+        for (const Entry &entry: other.buckets[b])
+            nodes.push_back(entry.node);
+        buckets[b].clear();
+        other.buckets[b].clear();
+    }
+    nonEmpty = other.nonEmpty = 0;
+    last = std::min(last, other.last);
+    for (Node<Value, Key> *x: nodes)
+        push(x);
+
+    size += other.size;
+    index.merge(other.index);
+    allocator.merge(other.allocator);
+    other.last = 0;
+    other.size = 0;
+    handler->verbose_log(6, "Meld function called.");
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+Node<Value, Key> *RadixHeap<Key, Value, Allocator>::extractMin() {
+    if (size == 0) {
+        handler->e_log(Keyed::notFound);
+        return nullptr;
+    }
+    settle();
+    Node<Value, Key> *minptr = buckets[0].back().node;
+    erase(minptr);
+    handler->verbose_log(6, "ExtractMin function called.");
+    return minptr;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+std::vector<typename RadixHeap<Key, Value, Allocator>::handle> RadixHeap<Key, Value, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    std::vector<Entry> sorted;
+    for (int b = 0; b < bucketCount && static_cast<int>(result.size()) < k; b++) {
+        sorted.assign(buckets[b].begin(), buckets[b].end());
+        std::size_t take = std::min<std::size_t>(sorted.size(), k - result.size());
+        std::partial_sort(sorted.begin(), sorted.begin() + take, sorted.end(),
+                          [](const Entry &a, const Entry &b) { return a.key < b.key; });
+        for (std::size_t i = 0; i < take; i++)
+            result.push_back(sorted[i].node);
+    }
+    return result;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+Node<Value, Key> *RadixHeap<Key, Value, Allocator>::displayMinimum() {
+    if (size == 0) return nullptr;
+    if (!buckets[0].empty())
+        return buckets[0].back().node;
+
+    // Peek without settling, which would raise last past keys callers may still insert
+    const std::vector<Entry> &bucket = buckets[lowestSetBit(nonEmpty)];
+    const Entry *lowest = &bucket.front();
+    for (const Entry &entry: bucket) {
+        if (entry.key < lowest->key)
+            lowest = &entry;
+    }
+    return lowest->node;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+void RadixHeap<Key, Value, Allocator>::display() {
+    handler->verbose_log(6, "Display Function called.");
+    if (size == 0) {
+        handler->e_log(Keyed::emptyHeap);
+        return;
+    }
+    for (int b = 0; b < bucketCount; b++) {
+        if (buckets[b].empty()) continue;
+        std::cout << "Bucket " << b << ":" << std::endl;
+        for (const Entry &entry: buckets[b])
+            std::cout << "  Key: " << entry.key << ", Name: " << entry.node->getName() << std::endl;
+    }
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+bool RadixHeap<Key, Value, Allocator>::isEmpty() {
+    return size == 0;
+}
+
+template<typename Key, typename Value, template<typename> class Allocator>
+int RadixHeap<Key, Value, Allocator>::getSize() {
+    return size;
+}
+
+#endif // RADIXHEAP_H
@@ -0,0 +1,526 @@
+#ifndef RANKPAIRINGHEAP_H
+#define RANKPAIRINGHEAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
+#include "error_handler.h"
+
+/**
+ * @class RankPairingHeap
+ * @brief Represents a type-1 rank-pairing heap with the same interface as FibHeap.
+ *
+ * The heap is a ring of half-ordered binary trees: every node's key is no greater
+ * than the keys in its left subtree, and a root has no right subtree. child is
+ * the left child, right the right child (or the next root for a root), left the
+ * previous root, and deg the rank. decreaseKey cuts the node together with its
+ * left subtree, then walks up lowering ranks until one is unchanged, with no
+ * marks and no cascading cuts. extractMin splits the minimum's left spine into
+ * roots and links roots of equal rank in a single pass.
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Compare Strict weak ordering on keys; the node that compares first is the minimum.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key>,
+    template<typename> class Allocator = NodePool>
+class RankPairingHeap : public KeyedHeap<RankPairingHeap<Key, Value, Compare, Allocator>, Key, Value, 9, Compare> {
+private:
+    using Keyed = KeyedHeap<RankPairingHeap, Key, Value, 9, Compare>;
+    friend Keyed;
+
+    Node<Value, Key> *min; ///< Root with the minimum key; the roots form a ring through left/right.
+    int size; ///< Number of nodes in the heap.
+    KeyIndex<Key, Value> index; ///< Key to node index backing find().
+    error_handler *handler;
+    Compare comp; ///< Key ordering; comp(a, b) means a belongs above b.
+    Allocator<Node<Value, Key> > allocator; ///< Storage for every node created through this heap.
+    std::vector<Node<Value, Key> *> pending; ///< Scratch list of roots reused by removeRoot().
+    std::vector<Node<Value, Key> *> rankTable; ///< Scratch table of one root per rank reused by removeRoot().
+
+    /**
+     * @brief Gets the rank of a subtree, -1 for a missing one.
+     */
+    static int rankOf(Node<Value, Key> *x);
+
+    /**
+     * @brief Adds an isolated half-tree to the root ring and updates the minimum.
+     *
+     * @param x The root of the half-tree.
+     */
+    void addRoot(Node<Value, Key> *x);
+
+    /**
+     * @brief Links two roots of equal rank into one root of the next rank.
+     *
+     * The loser becomes the left child of the winner and takes the winner's old
+     * left subtree as its right subtree.
+     *
+     * @param a The first root, outside the ring.
+     * @param b The second root, outside the ring.
+     * @return Node<Value, Key>* The winner.
+     */
+    Node<Value, Key> *link(Node<Value, Key> *a, Node<Value, Key> *b);
+
+    /**
+     * @brief Cuts a non-root node with its left subtree into a new root and repairs the ranks above it.
+     *
+     * @param x The node to cut.
+     */
+    void cut(Node<Value, Key> *x);
+
+    /**
+     * @brief Takes a root out of the heap, splits its left spine into roots and links the roots by rank.
+     *
+     * @param x The root to take out. Its key entry is left in the index.
+     */
+    void removeRoot(Node<Value, Key> *x);
+
+public:
+    /**
+     * @brief Stable reference to a node in the heap.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
+    /**
+     * @brief Constructs a new, empty rank-pairing heap.
+     */
+    RankPairingHeap(error_handler *handler);
+
+    /**
+     * @brief Destroys the heap and releases every node still in it.
+     */
+    ~RankPairingHeap();
+
+    RankPairingHeap(const RankPairingHeap &) = delete;
+    RankPairingHeap &operator=(const RankPairingHeap &) = delete;
+
+    /**
+     * @brief Allocates a node from the heap's allocator without inserting it.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The new node.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the heap to the allocator.
+     *
+     * @param x The node to release. Null is ignored.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the heap.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the heap as a new root of rank 0.
+     *
+     * @param x The node to be inserted.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the heap.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Lowers the key of a node and cuts it into a new root.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be greater than the current one.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node by taking it out and inserting it again.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be less than the current one.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the heap without searching for it.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another heap into this one by splicing the two root rings.
+     *
+     * @param other The heap to meld into this one. It is left empty.
+     */
+    void meld(RankPairingHeap &&other);
+
+    /**
+     * @brief Extracts the minimum node from the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists the k minimum nodes in order without modifying the heap.
+     *
+     * @param k The number of nodes to list.
+     * @return std::vector<handle> Up to k nodes in increasing key order.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the minimum node in the heap.
+     *
+     * @return Node<Value, Key>* The minimum node.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Displays the structure of the heap.
+     */
+    void display();
+
+    /**
+     * @brief Checks if the heap is empty.
+     *
+     * @return true If the heap is empty.
+     * @return false If the heap is not empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the heap.
+     *
+     * @return int The number of nodes in the heap.
+     */
+    int getSize();
+};
+
+// Implementation of the RankPairingHeap template class
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+RankPairingHeap<Key, Value, Compare, Allocator>::RankPairingHeap(error_handler *handler)
+    : min(nullptr), size(0), handler(handler) {}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+RankPairingHeap<Key, Value, Compare, Allocator>::~RankPairingHeap() {
+    clear();
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename RankPairingHeap<Key, Value, Compare, Allocator>::handle
+RankPairingHeap<Key, Value, Compare, Allocator>::createNode(Value Name, Key key) {
+    return allocator.allocate(Name, key);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void RankPairingHeap<Key, Value, Compare, Allocator>::destroyNode(handle x) {
+    allocator.deallocate(x);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void RankPairingHeap<Key, Value, Compare, Allocator>::clear() {
+    if constexpr (Allocator<Node<Value, Key> >::bulk_release && std::is_trivially_destructible<Node<Value, Key> >::value) {
+        allocator.release();
+    } else if (min != nullptr) {
+        std::vector<Node<Value, Key> *> stack;
+        Node<Value, Key> *r = min;
+        do {
+            stack.push_back(r);
+            r = r->right;
+        } while (r != min);
+        while (!stack.empty()) {
+            Node<Value, Key> *x = stack.back();
+            stack.pop_back();
+            if (x->child != nullptr)
+                stack.push_back(x->child);
+            if (x->parent != nullptr && x->right != nullptr)
+                stack.push_back(x->right);
+            allocator.deallocate(x);
+        }
+    }
+    min = nullptr;
+    index.clear();
+    size = 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int RankPairingHeap<Key, Value, Compare, Allocator>::rankOf(Node<Value, Key> *x) {
+    return x == nullptr ? -1 : x->deg;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void RankPairingHeap<Key, Value, Compare, Allocator>::addRoot(Node<Value, Key> *x) {
+    x->parent = nullptr;
+    if (min == nullptr) {
+        x->left = x->right = x;
+        min = x;
+        return;
+    }
+    x->right = min->right;
+    x->left = min;
+    min->right->left = x;
+    min->right = x;
+    if (comp(x->key, min->key))
+        min = x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *RankPairingHeap<Key, Value, Compare, Allocator>::link(Node<Value, Key> *a, Node<Value, Key> *b) {
+    if (comp(b->key, a->key))
+        std::swap(a, b);
+    b->right = a->child;
+    if (b->right != nullptr)
+        b->right->parent = b;
+    b->left = nullptr;
+    b->parent = a;
+    a->child = b;
+    ++a->deg;
+    return a;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void RankPairingHeap<Key, Value, Compare, Allocator>::cut(Node<Value, Key> *x) {
+    Node<Value, Key> *p = x->parent;
+    Node<Value, Key> *y = x->right;
+    if (p->child == x)
+        p->child = y;
+    else
+        p->right = y;
+    if (y != nullptr)
+        y->parent = p;
+    x->deg = rankOf(x->child) + 1;
+    addRoot(x);
+
+    // Lower the ranks above the cut until one stays the same
+    for (Node<Value, Key> *u = p; u != nullptr; u = u->parent) {
+        int r;
+        if (u->parent == nullptr) {
+            r = rankOf(u->child) + 1;
+        } else {
+            int r1 = rankOf(u->child), r2 = rankOf(u->right);
+            r = r1 != r2 ? std::max(r1, r2) : r1 + 1;
+        }
+        if (r >= u->deg)
+            break;
+        u->deg = r;
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void RankPairingHeap<Key, Value, Compare, Allocator>::removeRoot(Node<Value, Key> *x) {
+    pending.clear();
+    for (Node<Value, Key> *r = x->right; r != x; r = r->right)
+        pending.push_back(r);
+    for (Node<Value, Key> *c = x->child; c != nullptr;) {
+        Node<Value, Key> *next = c->right;
+        c->deg = rankOf(c->child) + 1;
+        pending.push_back(c);
+        c = next;
+    }
+    x->child = x->parent = nullptr;
+    x->left = x->right = x;
+    min = nullptr;
+
+    // One pass: link each root with the one waiting at its rank, or leave it waiting
+    for (Node<Value, Key> *r: pending) {
+        int rank = r->deg;
+        if (static_cast<int>(rankTable.size()) <= rank)
+            rankTable.resize(rank + 1, nullptr);
+        if (rankTable[rank] == nullptr) {
+            rankTable[rank] = r;
+        } else {
+            Node<Value, Key> *w = rankTable[rank];
+            rankTable[rank] = nullptr;
+            addRoot(link(r, w));
+        }
+    }
+    for (Node<Value, Key> *&r: rankTable) {
+        if (r != nullptr) {
+            addRoot(r);
+            r = nullptr;
+        }
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename RankPairingHeap<Key, Value, Compare, Allocator>::handle
+RankPairingHeap<Key, Value, Compare, Allocator>::insert(Node<Value, Key> *x) {
+    x->deg = 0;
+    x->child = nullptr;
+    x->mark = false;
+    addRoot(x);
+    index.insert(x);
+    ++size;
+    handler->verbose_log(9, "Insert function called.");
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename RankPairingHeap<Key, Value, Compare, Allocator>::handle
+RankPairingHeap<Key, Value, Compare, Allocator>::insert(Value Name, Key key) {
+    return insert(createNode(Name, key));
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void RankPairingHeap<Key, Value, Compare, Allocator>::decreaseKey(handle x, Key k) {
+    if (comp(x->key, k)) {
+        handler->e_log(9, "New key is greater than the current key.\n");
+        return;
+    }
+    index.erase(x);
+    x->key = k;
+    index.insert(x);
+    if (x->parent != nullptr)
+        cut(x);
+    else if (comp(x->key, min->key))
+        min = x;
+    handler->verbose_log(9, "DecreaseKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void RankPairingHeap<Key, Value, Compare, Allocator>::increaseKey(handle x, Key k) {
+    if (comp(k, x->key)) {
+        handler->e_log(9, "New key is less than the current key.\n");
+        return;
+    }
+    erase(x);
+    x->key = k;
+    insert(x);
+    handler->verbose_log(9, "IncreaseKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void RankPairingHeap<Key, Value, Compare, Allocator>::erase(handle x) {
+    if (x->parent != nullptr)
+        cut(x);
+    removeRoot(x);
+    index.erase(x);
+    --size;
+    handler->verbose_log(9, "Erase function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void RankPairingHeap<Key, Value, Compare, Allocator>::meld(RankPairingHeap &&other) {
+    if (&other == this || other.min == nullptr) return;
+
+    if (min == nullptr) {
+        min = other.min;
+    } else {
+        Node<Value, Key> *a = min->right, *b = other.min->right;
+        min->right = b;
+        b->left = min;
+        other.min->right = a;
+        a->left = other.min;
+        if (comp(other.min->key, min->key))
+            min = other.min;
+    }
+    size += other.size;
+    index.merge(other.index);
+    allocator.merge(other.allocator);
+    other.min = nullptr;
+    other.size = 0;
+    handler->verbose_log(9, "Meld function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *RankPairingHeap<Key, Value, Compare, Allocator>::extractMin() {
+    Node<Value, Key> *minptr = min;
+    if (minptr == nullptr) {
+        handler->e_log(Keyed::notFound);
+        return nullptr;
+    }
+    erase(minptr);
+    handler->verbose_log(9, "ExtractMin function called.");
+    return minptr;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+std::vector<typename RankPairingHeap<Key, Value, Compare, Allocator>::handle>
+RankPairingHeap<Key, Value, Compare, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    if (min == nullptr || k <= 0) return result;
+    auto later = [this](Node<Value, Key> *a, Node<Value, Key> *b) { return comp(b->key, a->key); };
+
+    std::vector<Node<Value, Key> *> candidates;
+    Node<Value, Key> *r = min;
+    do {
+        candidates.push_back(r);
+        r = r->right;
+    } while (r != min);
+    std::make_heap(candidates.begin(), candidates.end(), later);
+
+    result.reserve(std::min(k, size));
+    while (static_cast<int>(result.size()) < k && !candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), later);
+        Node<Value, Key> *x = candidates.back();
+        candidates.pop_back();
+        result.push_back(x);
+
+        // The right spine of x's left child holds the nodes whose only lower bound is x
+        for (Node<Value, Key> *c = x->child; c != nullptr; c = c->right) {
+            candidates.push_back(c);
+            std::push_heap(candidates.begin(), candidates.end(), later);
+        }
+    }
+    return result;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *RankPairingHeap<Key, Value, Compare, Allocator>::displayMinimum() {
+    return min;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void RankPairingHeap<Key, Value, Compare, Allocator>::display() {
+    handler->verbose_log(9, "Display Function called.");
+    if (!min) {
+        handler->e_log(Keyed::emptyHeap);
+        return;
+    }
+
+    std::function<void(Node<Value, Key>*, int)> displayNode = [&](Node<Value, Key>* node, int level) {
+        for (int i = 0; i < level; ++i) std::cout << "  ";
+        std::cout << "Key: " << node->getKey() << ", Name: " << node->getName() << ", Rank: " << node->deg << std::endl;
+        for (Node<Value, Key>* c = node->child; c != nullptr; c = c->right)
+            displayNode(c, level + 1);
+    };
+
+    Node<Value, Key>* r = min;
+    do {
+        displayNode(r, 0);
+        r = r->right;
+    } while (r != min);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+bool RankPairingHeap<Key, Value, Compare, Allocator>::isEmpty() {
+    return size == 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int RankPairingHeap<Key, Value, Compare, Allocator>::getSize() {
+    return size;
+}
+
+#endif // RANKPAIRINGHEAP_H
@@ -0,0 +1,844 @@
+#ifndef SOFTHEAP_H
+#define SOFTHEAP_H
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Node.h"
+#include "NodeAllocator.h"
+#include "PriorityQueue.h"
+#include "error_handler.h"
+
+/**
+ * @class SoftHeap
+ * @brief Represents a soft heap: an approximate priority queue with the same interface as FibHeap.
+ *
+ * This is the soft heap of Kaplan, Tarjan and Zwick. Nodes sit in lists hung on
+ * the cells of binary trees, and every cell carries one common key (ckey) for
+ * its whole list. When a list runs low it takes over a child's list together
+ * with the child's larger ckey, so the nodes it already held become corrupted:
+ * they are ordered by a key above their own. With error rate epsilon, at most
+ * epsilon * n nodes are corrupted at any time, where n counts the insertions so
+ * far and a key change as one more. In exchange extractMin costs
+ * O(log 1/epsilon) amortized and insert O(1).
+ *
+ * extractMin returns the front node of the root with the smallest ckey, which
+ * may not be the true minimum. corruptedExtractions() and outOfOrderExtractions()
+ * report how often that happened.
+ *
+ * Key changes and erase never search the lists. The node's list entry is
+ * cleared and a fresh entry is inserted instead; cleared entries are dropped
+ * when they reach the front of a root. Once cleared entries outnumber the
+ * nodes, the heap is rebuilt from its nodes, so space stays O(size) and the
+ * rebuild costs O(1) amortized per cleared entry. Every node keeps the index of
+ * its current entry in slot.
+ *
+ * @tparam Key The type of the keys that order the heap.
+ * @tparam Value The type of data stored in the heap nodes.
+ * @tparam Compare Strict weak ordering on keys; the node that compares first is the minimum.
+ * @tparam Allocator Policy that owns node storage, e.g. NodePool, NodeArena or NodeNewDelete.
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key>,
+    template<typename> class Allocator = NodePool>
+class SoftHeap : public KeyedHeap<SoftHeap<Key, Value, Compare, Allocator>, Key, Value, 14, Compare> {
+private:
+    using Keyed = KeyedHeap<SoftHeap, Key, Value, 14, Compare>;
+    friend Keyed;
+
+    /**
+     * @brief A tree cell. Links are indices into cells or entries, -1 meaning none.
+     */
+    struct Cell {
+        Key ckey; ///< Common key of every node in the list; no lower than any of their own keys.
+        int left; ///< Left child.
+        int right; ///< Right child.
+        int next; ///< Next root, of higher rank, while the cell is a root.
+        int suffixMin; ///< Root of smallest ckey among this root and the ones after it.
+        int rank; ///< Rank of the tree.
+        int target; ///< List length the cell refills to; targetAbove(rank - T).
+        int head; ///< First entry of the list.
+        int tail; ///< Last entry of the list.
+        int count; ///< Entries in the list, cleared ones included.
+    };
+
+    /**
+     * @brief A list entry holding one node, or none once the node has moved or left.
+     */
+    struct Entry {
+        Node<Value, Key> *item; ///< The node, or null if the entry was cleared.
+        int next; ///< Next entry in the same list.
+    };
+
+    std::vector<Cell> cells; ///< Storage for every cell.
+    std::vector<int> freeCells; ///< Released cell indices waiting to be reused.
+    std::vector<Entry> entries; ///< Storage for every list entry.
+    std::vector<int> freeEntries; ///< Released entry indices waiting to be reused.
+    std::vector<int> prefix; ///< Scratch list of roots whose suffix minima need refreshing.
+    std::vector<Node<Value, Key> *> survivors; ///< Scratch list of nodes reused by compact().
+    int cleared = 0; ///< Cleared entries still sitting in the lists.
+    int first; ///< Root of lowest rank, or -1.
+    int size; ///< Number of nodes in the heap.
+    int T; ///< Rank up to which cells hold a single entry; ceil(log2(errorFactor / epsilon)).
+    double epsilon; ///< Error rate the heap was built for.
+    long long corrupted = 0; ///< Extracted nodes whose ckey was above their own key.
+    long long outOfOrder = 0; ///< Extracted nodes that had to wait behind a node with a larger key.
+    Key lastKey{}; ///< Key of the last extracted node.
+    bool extracted = false; ///< Whether lastKey is set and no node has been placed since.
+    KeyIndex<Key, Value> index; ///< Key to node index backing find().
+    error_handler *handler;
+    Compare comp; ///< Key ordering; comp(a, b) means a belongs above b.
+    Allocator<Node<Value, Key> > allocator; ///< Storage for every node created through this heap.
+
+    static constexpr int maxTargetRank = 38; ///< Highest rank above T whose target still fits the arithmetic below.
+
+    /**
+     * @brief Upper bound, per 2^T insertions, on the nodes the sizing below can leave corrupted.
+     *
+     * Cells up to rank T hold one entry, which is never corrupted. There are at
+     * most n / 2^(T + j) cells of rank T + j, and such a cell only takes a child
+     * list while it is below its target. Its list therefore holds at most
+     * L(j) = L(j - 1) + target(j) - 1 entries, with L(0) = 1. T is chosen so that
+     * the sum of L(j) / 2^(T + j) stays under epsilon; the constructor checks this
+     * constant against corruptionFactor().
+     */
+    static constexpr double errorFactor = 6.25;
+
+    /**
+     * @brief List length a cell j ranks above T refills to: ceil((3/2)^j), or 1 for j <= 0.
+     */
+    static constexpr int targetAbove(int j);
+
+    /**
+     * @brief Computes the sum of L(j) / 2^j described at errorFactor for the targets targetAbove() hands out.
+     */
+    static constexpr double corruptionFactor();
+
+    /**
+     * @brief Creates an empty cell of the given rank.
+     */
+    int makeCell(int rank);
+
+    /**
+     * @brief Puts a node into a new rank-0 root.
+     */
+    void place(Node<Value, Key> *x);
+
+    /**
+     * @brief Checks whether a cell has no children.
+     */
+    bool leaf(int v) const;
+
+    /**
+     * @brief Refills a cell's list from its children until it reaches its target or the cell is a leaf.
+     */
+    void sift(int v);
+
+    /**
+     * @brief Joins two roots of equal rank under a new cell.
+     *
+     * @return int The new root.
+     */
+    int combine(int x, int y);
+
+    /**
+     * @brief Recomputes the suffix minimum of one root from the root after it.
+     */
+    void fixSuffixMin(int v);
+
+    /**
+     * @brief Recomputes the suffix minima of every root up to v, whose own ckey changed.
+     */
+    void refreshPrefix(int v);
+
+    /**
+     * @brief Pops the front entry of the root with the smallest ckey and repairs that root.
+     *
+     * @return Node<Value, Key>* The entry's node, or null if the entry was cleared.
+     */
+    Node<Value, Key> *popFront();
+
+    /**
+     * @brief Drops cleared entries until the front of the smallest root holds a node.
+     */
+    void settle();
+
+    /**
+     * @brief Forgets every cell and entry once the last node has left.
+     */
+    void reset();
+
+    /**
+     * @brief Clears a node's entry and rebuilds the heap from its nodes if cleared entries now outnumber them.
+     */
+    void clearEntry(Node<Value, Key> *x);
+
+    /**
+     * @brief Rebuilds the cells and lists from the nodes still in the heap, dropping every cleared entry.
+     */
+    void compact();
+
+public:
+    /**
+     * @brief Stable reference to a node in the heap.
+     */
+    using handle = Node<Value, Key> *;
+    using key_type = Key; ///< The type of the keys that order the heap.
+    using value_type = Value; ///< The type of data stored in the heap nodes.
+
+    /**
+     * @brief Constructs a new, empty soft heap.
+     *
+     * @param handler The error handler used for logging.
+     * @param epsilon Error rate between 0 and 1; smaller is more exact and slower.
+     */
+    SoftHeap(error_handler *handler, double epsilon = 0.125);
+
+    /**
+     * @brief Destroys the heap and releases every node still in it.
+     */
+    ~SoftHeap();
+
+    SoftHeap(const SoftHeap &) = delete;
+    SoftHeap &operator=(const SoftHeap &) = delete;
+
+    /**
+     * @brief Allocates a node from the heap's allocator without inserting it.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The new node.
+     */
+    handle createNode(Value Name, Key key);
+
+    /**
+     * @brief Returns a node that is no longer in the heap to the allocator.
+     *
+     * @param x The node to release. Null is ignored.
+     */
+    void destroyNode(handle x);
+
+    /**
+     * @brief Removes and releases every node in the heap and resets the counters.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts a node into the heap.
+     *
+     * @param x The node to be inserted.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Node<Value, Key> *x);
+
+    /**
+     * @brief Creates a node with the given name and key and inserts it into the heap.
+     *
+     * @param Name The name of the new node.
+     * @param key The key of the new node.
+     * @return handle The handle of the inserted node.
+     */
+    handle insert(Value Name, Key key);
+
+    /**
+     * @brief Lowers the key of a node by clearing its entry and inserting it again.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be greater than the current one.
+     */
+    void decreaseKey(handle x, Key k);
+
+    /**
+     * @brief Raises the key of a node by clearing its entry and inserting it again.
+     *
+     * @param x The handle of the node.
+     * @param k The new key, which must not be less than the current one.
+     */
+    void increaseKey(handle x, Key k);
+
+    /**
+     * @brief Removes a node from the heap without searching for it.
+     *
+     * Only the node's entry is cleared; the heap never touches the node again.
+     *
+     * @param x The handle of the node to be removed. Ownership goes back to the caller.
+     */
+    void erase(handle x);
+
+    /**
+     * @brief Melds another heap into this one by moving the smaller arrays over and merging the root lists.
+     *
+     * The other heap's counters are added to this one's.
+     *
+     * @param other The heap to meld into this one. It is left empty.
+     */
+    void meld(SoftHeap &&other);
+
+    /**
+     * @brief Extracts a node whose key is within the heap's error rate of the minimum.
+     *
+     * @return Node<Value, Key>* The front node of the root with the smallest ckey.
+     */
+    Node<Value, Key> *extractMin();
+
+    /**
+     * @brief Lists k nodes in approximate order without modifying the heap.
+     *
+     * Cells are visited in ckey order and their lists are listed front to back,
+     * so nodes are ordered by the ckey of their cell, not by their own key. A
+     * corrupted node can come after a node with a larger key, and the k nodes
+     * listed need not be the k smallest, just as with extractMin.
+     *
+     * @param k The number of nodes to list.
+     * @return std::vector<handle> Up to k nodes.
+     */
+    std::vector<handle> topK(int k) const;
+
+    /**
+     * @brief Displays the node the next extractMin would return.
+     *
+     * @return Node<Value, Key>* That node.
+     */
+    Node<Value, Key> *displayMinimum();
+
+    /**
+     * @brief Displays the structure of the heap, one line per cell.
+     */
+    void display();
+
+    /**
+     * @brief Checks if the heap is empty.
+     *
+     * @return true If the heap is empty.
+     * @return false If the heap is not empty.
+     */
+    bool isEmpty();
+
+    /**
+     * @brief Gets the size of the heap.
+     *
+     * @return int The number of nodes in the heap.
+     */
+    int getSize();
+
+    /**
+     * @brief Gets the error rate the heap was built for.
+     */
+    double errorRate() const;
+
+    /**
+     * @brief Counts extracted nodes that were corrupted, i.e. ordered by a ckey above their own key.
+     */
+    long long corruptedExtractions() const;
+
+    /**
+     * @brief Counts extractions that returned a node after one with a larger key.
+     *
+     * Only consecutive extractions with no insert or key change in between are
+     * compared, so every count is a node that really was in the heap while a
+     * larger one came out first. It is a lower bound on the true number.
+     */
+    long long outOfOrderExtractions() const;
+};
+
+// Implementation of the SoftHeap template class
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+SoftHeap<Key, Value, Compare, Allocator>::SoftHeap(error_handler *handler, double epsilon)
+    : first(-1), size(0), epsilon(epsilon), handler(handler) {
+    if (!(epsilon > 0.0 && epsilon < 1.0)) {
+        handler->e_log(14, "Error rate must be between 0 and 1, using 0.125.\n");
+        this->epsilon = 0.125;
+    }
+    static_assert(corruptionFactor() <= errorFactor, "SoftHeap cell targets can corrupt more than epsilon * n nodes");
+    T = std::max(0, static_cast<int>(std::ceil(std::log2(errorFactor / this->epsilon))));
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+constexpr int SoftHeap<Key, Value, Compare, Allocator>::targetAbove(int j) {
+    j = std::min(j, maxTargetRank);
+    long long num = 1;
+    long long den = 1;
+    for (int i = 0; i < j; ++i) {
+        num *= 3;
+        den *= 2;
+    }
+    return static_cast<int>((num + den - 1) / den);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+constexpr double SoftHeap<Key, Value, Compare, Allocator>::corruptionFactor() {
+    double factor = 0.0;
+    double weight = 1.0;
+    long long longest = 1;
+    for (int j = 1; j <= maxTargetRank; ++j) {
+        longest += targetAbove(j) - 1;
+        weight /= 2;
+        factor += longest * weight;
+    }
+    // Ranks above T + maxTargetRank would need more than 2^40 insertions; their share is below 1e-3
+    return factor + 1e-3;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+SoftHeap<Key, Value, Compare, Allocator>::~SoftHeap() {
+    clear();
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename SoftHeap<Key, Value, Compare, Allocator>::handle
+SoftHeap<Key, Value, Compare, Allocator>::createNode(Value Name, Key key) {
+    return allocator.allocate(Name, key);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::destroyNode(handle x) {
+    allocator.deallocate(x);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::clear() {
+    if constexpr (Allocator<Node<Value, Key> >::bulk_release && std::is_trivially_destructible<Node<Value, Key> >::value) {
+        allocator.release();
+    } else {
+        for (const Entry &entry: entries)
+            allocator.deallocate(entry.item);
+    }
+    reset();
+    index.clear();
+    size = 0;
+    corrupted = outOfOrder = 0;
+    extracted = false;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::reset() {
+    cells.clear();
+    freeCells.clear();
+    entries.clear();
+    freeEntries.clear();
+    first = -1;
+    cleared = 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::clearEntry(Node<Value, Key> *x) {
+    entries[x->slot].item = nullptr;
+    if (++cleared > size)
+        compact();
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::compact() {
+    survivors.clear();
+    for (const Entry &entry: entries) {
+        if (entry.item != nullptr)
+            survivors.push_back(entry.item);
+    }
+    reset();
+    for (Node<Value, Key> *x: survivors)
+        place(x);
+    handler->verbose_log(14, "Heap rebuilt without cleared entries.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int SoftHeap<Key, Value, Compare, Allocator>::makeCell(int rank) {
+    Cell cell{Key{}, -1, -1, -1, -1, rank, 1, -1, -1, 0};
+    int i;
+    if (!freeCells.empty()) {
+        i = freeCells.back();
+        freeCells.pop_back();
+        cells[i] = cell;
+    } else {
+        i = static_cast<int>(cells.size());
+        cells.push_back(cell);
+    }
+    cells[i].suffixMin = i;
+    return i;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::place(Node<Value, Key> *x) {
+    int e;
+    if (!freeEntries.empty()) {
+        e = freeEntries.back();
+        freeEntries.pop_back();
+        entries[e] = {x, -1};
+    } else {
+        e = static_cast<int>(entries.size());
+        entries.push_back({x, -1});
+    }
+    x->slot = e;
+    // A node placed now may sort before lastKey without anything having come out of order
+    extracted = false;
+
+    int v = makeCell(0);
+    cells[v].ckey = x->key;
+    cells[v].head = cells[v].tail = e;
+    cells[v].count = 1;
+    // Add the rank-0 root like a binary counter increment, combining while ranks collide
+    while (first != -1 && cells[first].rank == cells[v].rank) {
+        int f = first;
+        first = cells[f].next;
+        v = combine(f, v);
+    }
+    cells[v].next = first;
+    first = v;
+    fixSuffixMin(v);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+bool SoftHeap<Key, Value, Compare, Allocator>::leaf(int v) const {
+    return cells[v].left == -1 && cells[v].right == -1;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::sift(int v) {
+    while (cells[v].count < cells[v].target && !leaf(v)) {
+        if (cells[v].left == -1 ||
+            (cells[v].right != -1 && comp(cells[cells[v].right].ckey, cells[cells[v].left].ckey)))
+            std::swap(cells[v].left, cells[v].right);
+        int l = cells[v].left;
+
+        // Take over the child's list and its ckey, corrupting whatever v already held
+        if (cells[v].head == -1)
+            cells[v].head = cells[l].head;
+        else
+            entries[cells[v].tail].next = cells[l].head;
+        cells[v].tail = cells[l].tail;
+        cells[v].count += cells[l].count;
+        cells[v].ckey = cells[l].ckey;
+        cells[l].head = cells[l].tail = -1;
+        cells[l].count = 0;
+
+        if (leaf(l)) {
+            cells[v].left = -1;
+            freeCells.push_back(l);
+        } else {
+            sift(l);
+        }
+    }
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int SoftHeap<Key, Value, Compare, Allocator>::combine(int x, int y) {
+    int z = makeCell(cells[x].rank + 1);
+    cells[z].left = x;
+    cells[z].right = y;
+    cells[z].target = targetAbove(cells[z].rank - T);
+    sift(z);
+    return z;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::fixSuffixMin(int v) {
+    int next = cells[v].next;
+    if (next != -1 && comp(cells[cells[next].suffixMin].ckey, cells[v].ckey))
+        cells[v].suffixMin = cells[next].suffixMin;
+    else
+        cells[v].suffixMin = v;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::refreshPrefix(int v) {
+    prefix.clear();
+    for (int r = first; r != v; r = cells[r].next)
+        prefix.push_back(r);
+    fixSuffixMin(v);
+    for (auto it = prefix.rbegin(); it != prefix.rend(); ++it)
+        fixSuffixMin(*it);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *SoftHeap<Key, Value, Compare, Allocator>::popFront() {
+    int h = cells[first].suffixMin;
+    int e = cells[h].head;
+    Node<Value, Key> *x = entries[e].item;
+    cells[h].head = entries[e].next;
+    if (cells[h].head == -1)
+        cells[h].tail = -1;
+    --cells[h].count;
+    entries[e].item = nullptr;
+    freeEntries.push_back(e);
+    if (x == nullptr)
+        --cleared;
+
+    if (2 * cells[h].count <= cells[h].target) {
+        if (!leaf(h)) {
+            sift(h);
+            refreshPrefix(h);
+        } else if (cells[h].count == 0) {
+            prefix.clear();
+            for (int r = first; r != h; r = cells[r].next)
+                prefix.push_back(r);
+            if (prefix.empty())
+                first = cells[h].next;
+            else
+                cells[prefix.back()].next = cells[h].next;
+            freeCells.push_back(h);
+            for (auto it = prefix.rbegin(); it != prefix.rend(); ++it)
+                fixSuffixMin(*it);
+        }
+    }
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::settle() {
+    while (first != -1 && entries[cells[cells[first].suffixMin].head].item == nullptr)
+        popFront();
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename SoftHeap<Key, Value, Compare, Allocator>::handle
+SoftHeap<Key, Value, Compare, Allocator>::insert(Node<Value, Key> *x) {
+    place(x);
+    index.insert(x);
+    ++size;
+    handler->verbose_log(14, "Insert function called.");
+    return x;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+typename SoftHeap<Key, Value, Compare, Allocator>::handle
+SoftHeap<Key, Value, Compare, Allocator>::insert(Value Name, Key key) {
+    return insert(createNode(Name, key));
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::decreaseKey(handle x, Key k) {
+    if (comp(x->key, k)) {
+        handler->e_log(14, "New key is greater than the current key.\n");
+        return;
+    }
+    index.erase(x);
+    clearEntry(x);
+    x->key = k;
+    index.insert(x);
+    place(x);
+    handler->verbose_log(14, "DecreaseKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::increaseKey(handle x, Key k) {
+    if (comp(k, x->key)) {
+        handler->e_log(14, "New key is less than the current key.\n");
+        return;
+    }
+    index.erase(x);
+    clearEntry(x);
+    x->key = k;
+    index.insert(x);
+    place(x);
+    handler->verbose_log(14, "IncreaseKey function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::erase(handle x) {
+    index.erase(x);
+    if (--size == 0)
+        reset();
+    else
+        clearEntry(x);
+    handler->verbose_log(14, "Erase function called");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::meld(SoftHeap &&other) {
+    if (&other == this) return;
+
+    if (entries.size() < other.entries.size()) {
+        cells.swap(other.cells);
+        freeCells.swap(other.freeCells);
+        entries.swap(other.entries);
+        freeEntries.swap(other.freeEntries);
+        std::swap(first, other.first);
+    }
+    int cellOffset = static_cast<int>(cells.size());
+    int entryOffset = static_cast<int>(entries.size());
+    for (Cell cell: other.cells) {
+        for (int *link: {&cell.left, &cell.right, &cell.next, &cell.suffixMin})
+            if (*link != -1) *link += cellOffset;
+        if (cell.head != -1) cell.head += entryOffset;
+        if (cell.tail != -1) cell.tail += entryOffset;
+        cells.push_back(cell);
+    }
+    for (Entry entry: other.entries) {
+        if (entry.next != -1) entry.next += entryOffset;
+        if (entry.item != nullptr) entry.item->slot += entryOffset;
+        entries.push_back(entry);
+    }
+    for (int i: other.freeCells)
+        freeCells.push_back(i + cellOffset);
+    for (int i: other.freeEntries)
+        freeEntries.push_back(i + entryOffset);
+
+    // Merge the two root lists by rank, then combine equal ranks as in binomial heap union
+    int a = first;
+    int b = other.first == -1 ? -1 : other.first + cellOffset;
+    int head = -1;
+    int tail = -1;
+    while (a != -1 || b != -1) {
+        int r;
+        if (b == -1 || (a != -1 && cells[a].rank <= cells[b].rank)) {
+            r = a;
+            a = cells[a].next;
+        } else {
+            r = b;
+            b = cells[b].next;
+        }
+        if (tail == -1) head = r;
+        else cells[tail].next = r;
+        tail = r;
+    }
+    if (tail != -1) cells[tail].next = -1;
+    first = head;
+
+    int prev = -1;
+    int x = first;
+    while (x != -1 && cells[x].next != -1) {
+        int nx = cells[x].next;
+        int after = cells[nx].next;
+        if (cells[x].rank != cells[nx].rank || (after != -1 && cells[after].rank == cells[x].rank)) {
+            prev = x;
+            x = nx;
+        } else {
+            int z = combine(x, nx);
+            cells[z].next = after;
+            if (prev == -1) first = z;
+            else cells[prev].next = z;
+            x = z;
+        }
+    }
+    if (x != -1)
+        refreshPrefix(x);
+
+    size += other.size;
+    cleared += other.cleared;
+    corrupted += other.corrupted;
+    outOfOrder += other.outOfOrder;
+    index.merge(other.index);
+    allocator.merge(other.allocator);
+    other.reset();
+    other.size = 0;
+    other.corrupted = other.outOfOrder = 0;
+    other.extracted = false;
+    extracted = false;
+    handler->verbose_log(14, "Meld function called.");
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *SoftHeap<Key, Value, Compare, Allocator>::extractMin() {
+    if (size == 0) {
+        handler->e_log(Keyed::notFound);
+        return nullptr;
+    }
+    settle();
+    Key ckey = cells[cells[first].suffixMin].ckey;
+    Node<Value, Key> *minptr = popFront();
+    if (comp(minptr->key, ckey))
+        ++corrupted;
+    if (extracted && comp(minptr->key, lastKey))
+        ++outOfOrder;
+    lastKey = minptr->key;
+    extracted = true;
+    index.erase(minptr);
+    if (--size == 0)
+        reset();
+    handler->verbose_log(14, "ExtractMin function called.");
+    return minptr;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+std::vector<typename SoftHeap<Key, Value, Compare, Allocator>::handle>
+SoftHeap<Key, Value, Compare, Allocator>::topK(int k) const {
+    std::vector<handle> result;
+    if (size == 0 || k <= 0) return result;
+    auto later = [this](int a, int b) { return comp(cells[b].ckey, cells[a].ckey); };
+
+    std::vector<int> candidates;
+    for (int r = first; r != -1; r = cells[r].next)
+        candidates.push_back(r);
+    std::make_heap(candidates.begin(), candidates.end(), later);
+
+    result.reserve(std::min(k, size));
+    while (static_cast<int>(result.size()) < k && !candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), later);
+        int v = candidates.back();
+        candidates.pop_back();
+        for (int e = cells[v].head; e != -1 && static_cast<int>(result.size()) < k; e = entries[e].next) {
+            if (entries[e].item != nullptr)
+                result.push_back(entries[e].item);
+        }
+        for (int w: {cells[v].left, cells[v].right}) {
+            if (w != -1) {
+                candidates.push_back(w);
+                std::push_heap(candidates.begin(), candidates.end(), later);
+            }
+        }
+    }
+    return result;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+Node<Value, Key> *SoftHeap<Key, Value, Compare, Allocator>::displayMinimum() {
+    if (size == 0) return nullptr;
+    settle();
+    return entries[cells[cells[first].suffixMin].head].item;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+void SoftHeap<Key, Value, Compare, Allocator>::display() {
+    handler->verbose_log(14, "Display Function called.");
+    if (size == 0) {
+        handler->e_log(Keyed::emptyHeap);
+        return;
+    }
+
+    std::function<void(int, int)> displayCell = [&](int v, int level) {
+        if (v == -1) return;
+        for (int i = 0; i < level; ++i) std::cout << "  ";
+        std::cout << "CKey: " << cells[v].ckey << ", Rank: " << cells[v].rank << ", Nodes:";
+        for (int e = cells[v].head; e != -1; e = entries[e].next) {
+            if (entries[e].item != nullptr)
+                std::cout << " " << entries[e].item->getName() << " (" << entries[e].item->getKey() << ")";
+        }
+        std::cout << std::endl;
+        displayCell(cells[v].left, level + 1);
+        displayCell(cells[v].right, level + 1);
+    };
+
+    for (int r = first; r != -1; r = cells[r].next)
+        displayCell(r, 0);
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+bool SoftHeap<Key, Value, Compare, Allocator>::isEmpty() {
+    handler->verbose_log(14, "Is Empty Function called.");
+    return size == 0;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+int SoftHeap<Key, Value, Compare, Allocator>::getSize() {
+    return size;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+double SoftHeap<Key, Value, Compare, Allocator>::errorRate() const {
+    return epsilon;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+long long SoftHeap<Key, Value, Compare, Allocator>::corruptedExtractions() const {
+    return corrupted;
+}
+
+template<typename Key, typename Value, typename Compare, template<typename> class Allocator>
+long long SoftHeap<Key, Value, Compare, Allocator>::outOfOrderExtractions() const {
+    return outOfOrder;
+}
+
+#endif // SOFTHEAP_H
@@ -4,8 +4,16 @@
 #include <string>
 #include <array>
 #include <chrono>
+#include <mutex>
 #include <vector>
 
+/**
+ * @class error_handler
+ * @brief Logs errors to stderr and keeps them on screen for a few seconds.
+ *
+ * Every member function may be called from any thread: the concurrent engines
+ * log from their worker threads while the GUI thread renders the messages.
+ */
 class error_handler {
 private:
 
@@ -15,13 +23,26 @@ private:
     };
 
     std::vector<TimedMessage> activeMessages;
+    mutable std::mutex messageLock; ///< Guards activeMessages and keeps log lines from interleaving.
+    bool const verbose; ///< Whether verbose_log prints when FLAG_VERBOSE is set.
 
-    std::array<std::string, 5> const errorClass = {
+    std::array<std::string, 16> const errorClass = {
         "Hospital Task Manager: ", // ID: 0
         "Fibonacci Heap: ", // ID: 1
         "Doubly Circular Linked List: ", // ID: 2
         "VisualizeFibonacciHeap: ", // ID: 3
-        "VisualizeTaskManager: " // ID: 4
+        "VisualizeTaskManager: ", // ID: 4
+        "Pairing Heap: ", // ID: 5
+        "Radix Heap: ", // ID: 6
+        "D-ary Heap: ", // ID: 7
+        "Hollow Heap: ", // ID: 8
+        "Rank-Pairing Heap: ", // ID: 9
+        "Binomial Heap: ", // ID: 10
+        "Bucket Queue: ", // ID: 11
+        "Calendar Queue: ", // ID: 12
+        "Adaptive Heap: ", // ID: 13
+        "Soft Heap: ", // ID: 14
+        "MultiQueue: " // ID: 15
     };
     std::array<std::string, 30> const errorMessages = {
         "Priority must be a positive integer.\n", // ID: 0
@@ -39,10 +60,24 @@ private:
 
 public:
 
+    /**
+     * @brief Constructs an error handler.
+     *
+     * @param verbose false for a handler that never prints verbose output, e.g. one
+     * given to scratch heaps built on worker threads.
+     */
+    explicit error_handler(bool verbose = true) : verbose(verbose) {}
+
     void renderErrorMessages();
     void e_log(int id);
     void e_log(int id, std::string message);
-    void verbose_log( int classID, std::string msg) const;
+    void verbose_log(int classID, const std::string &msg) const;
+
+    /**
+     * @brief Prints a fixed verbose message. Builds no string unless verbose output is on,
+     * so the engines can log from their hot paths without allocating.
+     */
+    void verbose_log(int classID, const char *msg) const;
 
 
 };
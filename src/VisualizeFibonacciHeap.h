@@ -87,7 +87,7 @@ private:
      * @param heap Reference to the Fibonacci Heap.
      */
     void drawLinks(ImDrawList *drawList, Node<std::string> *node, NodePositionPair *nodePositions, int numPositions,
-                   const FibHeap<std::string> &heap) {
+                   const FibHeap<int, std::string> &heap) {
         if (node == nullptr) return;
 
         // Find the position of the current node
@@ -209,7 +209,7 @@ private:
      * @param heap Reference to the Fibonacci Heap.
      * @return Array of root nodes.
      */
-    NodeArray getRoots(const FibHeap<std::string> &heap) {
+    NodeArray getRoots(const FibHeap<int, std::string> &heap) {
         NodeArray roots = {{}, 0}; // Initialize NodeArray
         if (heap.min == nullptr) return roots;
 
@@ -233,9 +233,9 @@ private:
      */
     NodeArray getChildren(Node<std::string> *node) {
         NodeArray children = {{}, 0}; // Initialize NodeArray
-        if (node == nullptr || node->child == nullptr || node->child->head == nullptr) return children;
+        if (node == nullptr || node->child == nullptr) return children;
 
-        Node<std::string> *current = node->child->head;
+        Node<std::string> *current = node->child;
         do {
             if (children.count < MAX_NODES) {
                 children.nodes[children.count++] = current;
@@ -244,7 +244,7 @@ private:
                 handler->e_log(4, "Maximum number of nodes reached in getChildren.");
                 break;
             }
-        } while (current != node->child->head);
+        } while (current != node->child);
         return children;
     }
 
@@ -258,7 +258,7 @@ public:
      * @brief Visualizes the Fibonacci Heap.
      * @param heap Reference to the Fibonacci Heap.
      */
-    void visualize(FibHeap<std::string> &heap) {
+    void visualize(FibHeap<int, std::string> &heap) {
         ImGui::Begin("Fibonacci Heap Visualization");
 
         // --- Control Panel ---
@@ -286,8 +286,7 @@ public:
             if (ImGui::Button("Insert")) {
                 if (insertValue >= 0 && heap.find(insertValue) == nullptr) {
                     std::string nameStr(insertName);
-                    Node<std::string> *node = new Node<std::string>(nameStr, insertValue);
-                    heap.insert(node);
+                    heap.insert(nameStr, insertValue);
                 }
                 else
                 {
@@ -305,7 +304,7 @@ public:
             // Button to extract the minimum node
             // ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(15, 15)); // Increase button size
             if (ImGui::Button("Extract-Min")) {
-                heap.extractMin();
+                heap.destroyNode(heap.extractMin());
             }
             // ImGui::PopStyleVar();
 
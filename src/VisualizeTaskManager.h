@@ -9,7 +9,8 @@
 class VisualizeTaskManager
 {
 public:
-    void visualize(HospitalTaskManager& manager, error_handler* error_handler)
+    template <typename Engine>
+    void visualize(HospitalTaskManager<Engine>& manager, error_handler* error_handler)
     {
         // Set global font scale
 
@@ -94,7 +95,7 @@ public:
 
         if (ImGui::BeginPopup("Display Patient"))
         {
-            Node<std::string>* curr = manager.getTaskCopy(displayPriority);
+            auto* curr = manager.getTaskCopy(displayPriority);
             ImGui::Text("Name: %s", curr->getName().c_str());
             ImGui::Text("Priority: %d", curr->getKey());
             if (curr->getData() != nullptr)
@@ -108,7 +109,7 @@ public:
         static bool initialized = false;
         if (ImGui::BeginPopup("Edit Patient"))
         {
-            Node<std::string>* curr = manager.taskHeap->find(displayPriority);
+            auto* curr = manager.taskHeap->find(displayPriority);
             static int taskPriority;
             static char Name[128];
             static int Age;
@@ -210,7 +211,8 @@ public:
     }
 
 private:
-    void displayTasks(HospitalTaskManager& manager)
+    template <typename Engine>
+    void displayTasks(HospitalTaskManager<Engine>& manager)
     {
         if (ImGui::BeginTable("TasksTable", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
         {
@@ -219,33 +221,18 @@ private:
             ImGui::TableSetupColumn("Priority");
             ImGui::TableHeadersRow();
 
-            // Display each task in the table
-            traverseHeap(manager.taskHeap->displayMinimum());
-
-            ImGui::EndTable();
-        }
-    }
-
-    void traverseHeap(Node<std::string>* node)
-    {
-        if (!node) return;
-
-        Node<std::string>* start = node;
-        do
-        {
-            ImGui::TableNextRow();
-            ImGui::TableSetColumnIndex(0);
-            ImGui::Text("%s", node->getName().c_str());
-            ImGui::TableSetColumnIndex(1);
-            ImGui::Text("%d", node->getKey());
-
-            if (node->child)
+            // Display the tasks in priority order
+            for (auto* node : manager.taskHeap->topK(manager.countTasks()))
             {
-                traverseHeap(node->child->head);
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Text("%s", node->getName().c_str());
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%d", node->getKey());
             }
-            node = node->right;
+
+            ImGui::EndTable();
         }
-        while (node != start);
     }
 };
 
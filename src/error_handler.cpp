@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <mutex>
 
 #include "_env.h"
 
@@ -12,21 +13,29 @@
 void error_handler::e_log(int id) {
     int classID = id / 10;
     int errorID = id % 10;
+    std::lock_guard<std::mutex> lock(messageLock);
     std::cerr << std::endl << errorClass[classID] + errorMessages[errorID];
     addErrorMessage(errorClass[classID] + errorMessages[errorID], 4000);
 }
 
 void error_handler::e_log(int id, std::string msg) {
+    std::lock_guard<std::mutex> lock(messageLock);
     std::cerr << std::endl << errorClass[id] + msg;
     addErrorMessage(errorClass[id] + msg, 4000);
 }
 
-void error_handler::verbose_log(int classID, std::string msg) const {
-    if (FLAG_VERBOSE) {
-        std::cout << std::endl << errorClass[classID] + msg;
+void error_handler::verbose_log(int classID, const std::string &msg) const {
+    verbose_log(classID, msg.c_str());
+}
+
+void error_handler::verbose_log(int classID, const char *msg) const {
+    if (verbose && FLAG_VERBOSE) {
+        std::lock_guard<std::mutex> lock(messageLock);
+        std::cout << std::endl << errorClass[classID] << msg;
     }
 }
 
+// Callers hold messageLock
 void error_handler::addErrorMessage(const std::string &message, int durationMS) {
     TimedMessage timedMessage;
     timedMessage.message = message;
@@ -37,6 +46,7 @@ void error_handler::addErrorMessage(const std::string &message, int durationMS)
 
 void error_handler::renderErrorMessages() {
     auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(messageLock);
     for (auto it = activeMessages.begin(); it != activeMessages.end(); ) {
         if (now > it->endTime) {
             it = activeMessages.erase(it);
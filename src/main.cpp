@@ -59,7 +59,7 @@ int main(int, char **) {
     error_handler handler;
 
     // Create an instance of your Fibonacci Heap (using std::string for the Name)
-    FibHeap<std::string> myHeap(&handler);
+    FibHeap<int, std::string> myHeap(&handler);
 
     // Create an instance of the visualization class
     VisualizeFibonacciHeap visualizer(&handler);
@@ -80,6 +80,9 @@ int main(int, char **) {
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
 
+        // Apply tasks that other threads submitted since the last frame
+        taskManager.drainAdmissions();
+
         // Call your visualization function
         visualizer.visualize(myHeap);
         manager.visualize(taskManager, &handler);